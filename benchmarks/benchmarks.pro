@@ -0,0 +1,10 @@
+# Standalone benchmarks for the hot paths of chatterino.
+# Build them separately from the main project:
+#   qmake benchmarks/benchmarks.pro && make
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    linkparser \
+    rendering \
+    replay
@@ -0,0 +1,170 @@
+#include "benchmarkhelpers.hpp"
+
+#include "application.hpp"
+#include "singletons/loggingmanager.hpp"
+#include "singletons/settingsmanager.hpp"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace chatterino {
+namespace benchmarks {
+
+uint64_t getAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t getPeakRSS()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#ifdef Q_OS_MACOS
+    // bytes on macOS, kilobytes everywhere else
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+void initializeHeadlessApplication(int argc, char **argv)
+{
+    // keep settings, caches and logs apart from a real installation
+    QCoreApplication::setApplicationName("chatterino-benchmarks");
+
+    Application::instantiate(argc, argv);
+    auto app = getApp();
+
+    app->construct();
+
+    app->logging->initialize();
+    app->settings->updateWordTypeMask();
+}
+
+std::vector<QByteArray> loadTranscript(const QString &path)
+{
+    std::vector<QByteArray> lines;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Unable to open transcript" << path;
+        return lines;
+    }
+
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+
+        while (line.endsWith('\n') || line.endsWith('\r')) {
+            line.chop(1);
+        }
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+StageTimings::StageTimings(const char *_name)
+    : name(_name)
+{
+}
+
+void StageTimings::add(int64_t nanoseconds)
+{
+    this->samples.push_back(nanoseconds);
+    this->total += nanoseconds;
+}
+
+int64_t StageTimings::getTotal() const
+{
+    return this->total;
+}
+
+size_t StageTimings::getCount() const
+{
+    return this->samples.size();
+}
+
+void StageTimings::print()
+{
+    if (this->samples.empty()) {
+        qDebug().noquote() << QString("%1: no samples").arg(this->name, -10);
+        return;
+    }
+
+    std::sort(this->samples.begin(), this->samples.end());
+
+    auto percentile = [this](double p) {
+        auto index = size_t(p * (this->samples.size() - 1));
+        return this->samples[index] / 1000.0;
+    };
+
+    qDebug().noquote() << QString("%1: n=%2 mean=%3us p50=%4us p90=%5us p99=%6us max=%7us")
+                              .arg(this->name, -10)
+                              .arg(this->samples.size())
+                              .arg(this->total / 1000.0 / this->samples.size(), 0, 'f', 1)
+                              .arg(percentile(0.5), 0, 'f', 1)
+                              .arg(percentile(0.9), 0, 'f', 1)
+                              .arg(percentile(0.99), 0, 'f', 1)
+                              .arg(this->samples.back() / 1000.0, 0, 'f', 1);
+}
+
+}  // namespace benchmarks
+}  // namespace chatterino
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+namespace benchmarks {
+
+// Number of calls to the global operator new since the start of the process
+uint64_t getAllocationCount();
+
+// Peak resident set size of the process in kilobytes, 0 if unknown
+uint64_t getPeakRSS();
+
+// Constructs the application without loading the user's settings and without starting the
+// network thread, so requests for emotes, badges and chatters are queued but never sent.
+// Must be called after the QApplication was created.
+void initializeHeadlessApplication(int argc, char **argv);
+
+// Reads raw IRC lines from a transcript, skipping empty lines and lines starting with '#'
+std::vector<QByteArray> loadTranscript(const QString &path);
+
+// Collects durations of a single stage of the pipeline
+class StageTimings
+{
+public:
+    explicit StageTimings(const char *name);
+
+    void add(int64_t nanoseconds);
+
+    int64_t getTotal() const;
+    size_t getCount() const;
+
+    // Prints the sample count, mean and p50/p90/p99/max in microseconds
+    void print();
+
+private:
+    const char *name;
+    std::vector<int64_t> samples;
+    int64_t total = 0;
+};
+
+}  // namespace benchmarks
+}  // namespace chatterino
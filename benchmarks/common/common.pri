@@ -0,0 +1,13 @@
+# Helpers shared by the benchmarks that link the whole application
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/benchmarkhelpers.cpp
+
+HEADERS += \
+    $$PWD/benchmarkhelpers.hpp
+
+win32 {
+    LIBS += -lpsapi
+}
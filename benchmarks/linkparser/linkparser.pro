@@ -0,0 +1,18 @@
+# Compares LinkParser against the regex previously used by MessageBuilder::matchLink
+
+QT            -= gui
+QT            += core
+CONFIG        += c++14 console
+CONFIG        -= app_bundle
+TARGET         = linkparser-benchmark
+TEMPLATE       = app
+INCLUDEPATH   += ../../src/
+DEFINES       += BENCHMARK_RESOURCES_DIR=\\\"$$PWD/../resources\\\"
+
+SOURCES += \
+    main.cpp \
+    ../../src/messages/linkparser.cpp
+
+HEADERS += \
+    ../../src/messages/linkparser.hpp \
+    ../../src/messages/tldtable.hpp
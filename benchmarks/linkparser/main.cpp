@@ -0,0 +1,123 @@
+#include "messages/linkparser.hpp"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTextStream>
+
+using namespace chatterino::messages;
+
+namespace {
+
+// MessageBuilder::matchLink before it was replaced by LinkParser
+QString matchLinkRegex(const QString &string)
+{
+    static QRegularExpression linkRegex("[[:ascii:]]*\\.[a-zA-Z]+\\/?[[:ascii:]]*");
+    static QRegularExpression httpRegex("\\bhttps?://");
+
+    auto match = linkRegex.match(string);
+
+    if (!match.hasMatch()) {
+        return QString();
+    }
+
+    QString captured = match.captured();
+
+    if (!captured.contains(httpRegex)) {
+        captured.insert(0, "http://");
+    }
+
+    return captured;
+}
+
+QString matchLinkParser(const QString &string)
+{
+    LinkParser linkParser(string);
+
+    if (!linkParser.hasMatch()) {
+        return QString();
+    }
+
+    QString captured = linkParser.getCaptured();
+
+    if (!linkParser.hasScheme()) {
+        captured.insert(0, "http://");
+    }
+
+    return captured;
+}
+
+template <typename Func>
+void run(const char *name, const QStringList &words, int iterations, Func &&func)
+{
+    int matches = 0;
+
+    // warm up static state
+    func(words.first());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; i++) {
+        for (const QString &word : words) {
+            if (!func(word).isEmpty()) {
+                matches++;
+            }
+        }
+    }
+
+    qint64 elapsed = timer.nsecsElapsed();
+    qint64 total = qint64(words.size()) * iterations;
+
+    qDebug().noquote() << QString("%1: %2 ms total, %3 ns/word, %4 links")
+                              .arg(name, -8)
+                              .arg(elapsed / 1000000.0, 0, 'f', 2)
+                              .arg(double(elapsed) / total, 0, 'f', 1)
+                              .arg(matches / iterations);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QString path = BENCHMARK_RESOURCES_DIR "/chatlines.txt";
+    int iterations = 200;
+
+    if (argc > 1) {
+        path = argv[1];
+    }
+    if (argc > 2) {
+        iterations = QString(argv[2]).toInt();
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Unable to open" << path;
+        return 1;
+    }
+
+    // words are split the same way TwitchMessageBuilder::build splits them
+    QStringList words;
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    while (!stream.atEnd()) {
+        words.append(stream.readLine().split(' ', QString::SkipEmptyParts));
+    }
+
+    if (words.isEmpty()) {
+        qDebug() << "No words in" << path;
+        return 1;
+    }
+
+    qDebug().noquote() << words.size() << "words," << iterations << "iterations";
+
+    run("regex", words, iterations, matchLinkRegex);
+    run("parser", words, iterations, matchLinkParser);
+
+    return 0;
+}
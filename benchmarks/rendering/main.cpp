@@ -0,0 +1,367 @@
+#include "application.hpp"
+#include "benchmarkhelpers.hpp"
+#include "messages/layouts/messagelayout.hpp"
+#include "providers/twitch/twitchserver.hpp"
+#include "singletons/emotemanager.hpp"
+#include "singletons/pathmanager.hpp"
+#include "widgets/helper/channelview.hpp"
+
+#include <IrcMessage>
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPixmap>
+#include <QUrl>
+
+#include <functional>
+#include <map>
+
+using namespace chatterino;
+using namespace chatterino::benchmarks;
+using namespace chatterino::messages;
+using namespace chatterino::messages::layouts;
+using namespace chatterino::widgets;
+
+namespace {
+
+struct Options {
+    QString transcriptPath = BENCHMARK_RESOURCES_DIR "/transcript.irc";
+    QString emotesPath = BENCHMARK_RESOURCES_DIR "/emotes";
+    QString channelName;
+    int frames = 300;
+    int messages = 1000;
+    int width = 500;
+    int height = 600;
+};
+
+Options parseOptions(const QCoreApplication &app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Renders a ChannelView offscreen and reports layout and paint frame times");
+    parser.addHelpOption();
+    parser.addPositionalArgument("transcript", "Transcript with one raw IRC line per line");
+
+    QCommandLineOption emotesOption(
+        "emotes", "Directory with Twitch emote images named <emote id>.<extension>", "directory",
+        BENCHMARK_RESOURCES_DIR "/emotes");
+    QCommandLineOption channelOption(
+        "channel", "Channel that is shown, defaults to the busiest channel of the transcript",
+        "name");
+    QCommandLineOption framesOption("frames", "Frames rendered per scenario", "count", "300");
+    QCommandLineOption messagesOption("messages", "Messages in the channel before rendering",
+                                      "count", "1000");
+    QCommandLineOption widthOption("width", "Width of the view", "pixels", "500");
+    QCommandLineOption heightOption("height", "Height of the view", "pixels", "600");
+
+    parser.addOption(emotesOption);
+    parser.addOption(channelOption);
+    parser.addOption(framesOption);
+    parser.addOption(messagesOption);
+    parser.addOption(widthOption);
+    parser.addOption(heightOption);
+
+    parser.process(app);
+
+    Options options;
+
+    if (!parser.positionalArguments().isEmpty()) {
+        options.transcriptPath = parser.positionalArguments().first();
+    }
+
+    options.emotesPath = parser.value(emotesOption);
+    options.channelName = parser.value(channelOption).toLower();
+    options.frames = std::max(2, parser.value(framesOption).toInt());
+    options.messages = std::max(1, parser.value(messagesOption).toInt());
+    options.width = std::max(100, parser.value(widthOption).toInt());
+    options.height = std::max(100, parser.value(heightOption).toInt());
+
+    return options;
+}
+
+// Copies the emote images of a directory into the quick load cache, so Image reads them from
+// disk instead of requesting them. Returns the number of emotes that were copied.
+int seedEmoteCache(const QString &directory)
+{
+    auto app = getApp();
+    int count = 0;
+
+    for (const QFileInfo &info : QDir(directory).entryInfoList(QDir::Files)) {
+        bool ok = false;
+        long id = info.baseName().toLong(&ok);
+        if (!ok) {
+            continue;
+        }
+
+        QFile file(info.filePath());
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        QByteArray bytes = file.readAll();
+
+        for (const char *scale : {"1.0", "2.0", "3.0"}) {
+            QString url =
+                QString("https://static-cdn.jtvnw.net/emoticons/v1/%1/%2").arg(id).arg(scale);
+
+            // same key NetworkRequest uses for a request without headers
+            QByteArray hash =
+                QCryptographicHash::hash(QUrl(url).toString().toUtf8(), QCryptographicHash::Sha256)
+                    .toHex();
+
+            QFile cachedFile(app->paths->cacheFolderPath + "/" + hash);
+            if (cachedFile.open(QIODevice::WriteOnly)) {
+                cachedFile.write(bytes);
+            }
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+// Channel with the most PRIVMSGs in the transcript
+QString findBusiestChannel(const std::vector<QByteArray> &lines)
+{
+    std::map<QString, int> counts;
+
+    for (const QByteArray &line : lines) {
+        auto message = Communi::IrcMessage::fromData(line, nullptr);
+        QString target = message->parameters().value(0);
+        if (message->type() == Communi::IrcMessage::Private && target.startsWith('#')) {
+            counts[target.mid(1)]++;
+        }
+        delete message;
+    }
+
+    QString busiest;
+    int busiestCount = 0;
+
+    for (const auto &pair : counts) {
+        if (pair.second > busiestCount) {
+            busiest = pair.first;
+            busiestCount = pair.second;
+        }
+    }
+
+    return busiest;
+}
+
+// Renders one scripted scenario. Every frame calls step, which may lay out the view, and then
+// paints the view synchronously.
+class Scenario
+{
+public:
+    Scenario(const char *_name, ChannelView &_view)
+        : name(_name)
+        , view(_view)
+    {
+    }
+
+    void run(int frames, const std::function<void(int)> &step)
+    {
+        StageTimings layoutTimings("layout");
+        StageTimings paintTimings("paint");
+        StageTimings bufferTimings("buffer");
+        StageTimings frameTimings("frame");
+
+        QElapsedTimer timer;
+
+        for (int i = 0; i < frames; i++) {
+            timer.start();
+
+            step(i);
+            int64_t layoutTime = timer.nsecsElapsed();
+
+            this->view.repaint();
+            int64_t frameTime = timer.nsecsElapsed();
+
+            layoutTimings.add(layoutTime);
+            paintTimings.add(frameTime - layoutTime);
+            frameTimings.add(frameTime);
+
+            this->measureBuffers(bufferTimings);
+
+            // deliver queued events outside of the measured frame
+            QCoreApplication::processEvents();
+        }
+
+        qDebug().noquote() << QString("%1 (%2 frames)").arg(this->name).arg(frames);
+        layoutTimings.print();
+        paintTimings.print();
+        bufferTimings.print();
+        frameTimings.print();
+    }
+
+private:
+    const char *name;
+    ChannelView &view;
+
+    // MessageLayout::updateBuffer is private, so it is measured by painting every message on
+    // screen again after invalidating its buffer.
+    void measureBuffers(StageTimings &timings)
+    {
+        auto snapshot = this->view.getMessagesSnapshot();
+        size_t start = size_t(this->view.getScrollBar().getCurrentValue());
+
+        QPixmap target(this->view.size());
+        QPainter painter(&target);
+        Selection selection;
+        QElapsedTimer timer;
+
+        int y = 0;
+        for (size_t i = start; i < snapshot.getLength() && y < this->view.height(); i++) {
+            auto &layout = snapshot[i];
+
+            layout->invalidateBuffer();
+
+            timer.start();
+            layout->paint(painter, y, int(i), selection, false, true, false);
+            timings.add(timer.nsecsElapsed());
+
+            y += layout->getHeight();
+        }
+    }
+};
+
+void sendMouseEvent(QWidget &widget, QEvent::Type type, QPoint position, Qt::MouseButtons buttons)
+{
+    QMouseEvent event(type, position, Qt::LeftButton, buttons, Qt::NoModifier);
+    QApplication::sendEvent(&widget, &event);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    // render without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication::setAttribute(Qt::AA_Use96Dpi, true);
+    QApplication a(argc, argv);
+
+    Options options = parseOptions(a);
+
+    std::vector<QByteArray> lines = loadTranscript(options.transcriptPath);
+    if (lines.empty()) {
+        qDebug() << "No messages to replay";
+        return 1;
+    }
+
+    initializeHeadlessApplication(argc, argv);
+    auto app = getApp();
+    auto server = app->twitch.server;
+
+    int emoteCount = seedEmoteCache(options.emotesPath);
+    if (emoteCount == 0) {
+        qDebug() << "No emote images found in" << options.emotesPath;
+    }
+
+    if (options.channelName.isEmpty()) {
+        options.channelName = findBusiestChannel(lines);
+    }
+
+    ChannelPtr channel = server->getOrAddChannel(options.channelName);
+
+    // keep the built messages around so the append scenario doesn't measure message building
+    std::vector<MessagePtr> builtMessages;
+    auto collectConnection = channel->messageAppended.connect(
+        [&](auto &message) { builtMessages.push_back(message); });
+
+    ChannelView view;
+    view.resize(options.width, options.height);
+    view.setChannel(channel);
+    view.show();
+
+    a.processEvents();
+
+    // fill the channel, the transcript is repeated until there are enough messages
+    for (size_t i = 0; builtMessages.size() < size_t(options.messages) && i < lines.size() * 100;
+         i++) {
+        // the server deletes the parsed messages, they don't need a connection as parent
+        server->addFakeMessage(Communi::IrcMessage::fromData(lines[i % lines.size()], nullptr));
+
+        if (i % 64 == 0) {
+            a.processEvents();
+        }
+    }
+
+    collectConnection.disconnect();
+
+    if (builtMessages.empty()) {
+        qDebug() << "No messages for channel" << options.channelName;
+        return 1;
+    }
+
+    // images are loaded on the first paint and the view is laid out again 500ms later
+    view.repaint();
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    while (loadTimer.elapsed() < 600) {
+        a.processEvents();
+    }
+
+    qDebug().noquote() << QString("Rendering #%1 with %2 messages and %3 emote images at %4x%5")
+                              .arg(options.channelName)
+                              .arg(builtMessages.size())
+                              .arg(emoteCount)
+                              .arg(options.width)
+                              .arg(options.height);
+
+    auto &scrollBar = view.getScrollBar();
+    int frames = options.frames;
+
+    Scenario("scroll", view).run(frames, [&](int i) {
+        // scroll up for the first half of the frames and back down for the second half
+        qreal bottom = scrollBar.getMaximum() - scrollBar.getLargeChange();
+        qreal distance = i < frames / 2 ? i : frames - i;
+        scrollBar.setDesiredValue(std::max(0.0, bottom - distance * 0.75), false);
+    });
+
+    scrollBar.scrollToBottom(false);
+
+    Scenario("resize", view).run(frames, [&](int i) {
+        int width = options.width - (i % 20) * options.width / 40;
+        view.resize(width, options.height);
+    });
+
+    view.resize(options.width, options.height);
+
+    Scenario("select", view).run(frames, [&](int i) {
+        int x = 10 + (i * 37) % (options.width - 30);
+        int y = 10 + i * (options.height - 20) / frames;
+
+        if (i == 0) {
+            sendMouseEvent(view, QEvent::MouseButtonPress, QPoint(x, y), Qt::LeftButton);
+        } else if (i == frames - 1) {
+            sendMouseEvent(view, QEvent::MouseButtonRelease, QPoint(x, y), Qt::NoButton);
+        } else {
+            sendMouseEvent(view, QEvent::MouseMove, QPoint(x, y), Qt::LeftButton);
+        }
+    });
+
+    view.clearSelection();
+
+    auto &gifUpdateSignal = app->emotes->getGifUpdateSignal();
+    Scenario("gif", view).run(frames, [&](int) {
+        // what the gif timer does every 30ms
+        gifUpdateSignal.invoke();
+    });
+
+    Scenario("append", view).run(frames, [&](int i) {
+        channel->addMessage(builtMessages[size_t(i) % builtMessages.size()]);
+    });
+
+    qDebug().noquote() << QString("peak rss: %1 KiB").arg(getPeakRSS());
+
+    // the singletons are never destroyed, same as in the application
+    _exit(0);
+}
@@ -0,0 +1,14 @@
+# Renders a ChannelView on the offscreen platform while scrolling, resizing, selecting and
+# animating emotes. See main.cpp for the available options.
+
+include(../../chatterino.pri)
+include(../common/common.pri)
+
+TARGET     = rendering-benchmark
+TEMPLATE   = app
+CONFIG    += console
+CONFIG    -= app_bundle
+DEFINES   += BENCHMARK_RESOURCES_DIR=\\\"$$PWD/../resources\\\"
+
+SOURCES += \
+    main.cpp
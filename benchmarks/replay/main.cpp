@@ -0,0 +1,205 @@
+#include "application.hpp"
+#include "benchmarkhelpers.hpp"
+#include "messages/layouts/messagelayout.hpp"
+#include "providers/twitch/twitchserver.hpp"
+#include "singletons/settingsmanager.hpp"
+
+#include <IrcMessage>
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <deque>
+#include <set>
+
+using namespace chatterino;
+using namespace chatterino::benchmarks;
+using namespace chatterino::messages::layouts;
+
+namespace {
+
+// same limit as the message queue of a Channel
+const size_t maxLayoutsPerChannel = 1000;
+
+struct Options {
+    QString transcriptPath = BENCHMARK_RESOURCES_DIR "/transcript.irc";
+    int loops = 20;
+    double rate = 0;
+    int width = 500;
+    float scale = 1;
+};
+
+Options parseOptions(const QCoreApplication &app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Replays an IRC transcript through the message pipeline and reports timings");
+    parser.addHelpOption();
+    parser.addPositionalArgument("transcript", "Transcript with one raw IRC line per line");
+
+    QCommandLineOption loopsOption("loops", "How often the transcript is replayed", "count", "20");
+    QCommandLineOption rateOption("rate", "Messages per second, 0 for as fast as possible", "rate",
+                                  "0");
+    QCommandLineOption widthOption("width", "Width the messages are laid out at", "pixels", "500");
+    QCommandLineOption scaleOption("scale", "Scale the messages are laid out at", "scale", "1");
+
+    parser.addOption(loopsOption);
+    parser.addOption(rateOption);
+    parser.addOption(widthOption);
+    parser.addOption(scaleOption);
+
+    parser.process(app);
+
+    Options options;
+
+    if (!parser.positionalArguments().isEmpty()) {
+        options.transcriptPath = parser.positionalArguments().first();
+    }
+
+    options.loops = std::max(1, parser.value(loopsOption).toInt());
+    options.rate = std::max(0.0, parser.value(rateOption).toDouble());
+    options.width = std::max(50, parser.value(widthOption).toInt());
+    options.scale = std::max(0.1f, parser.value(scaleOption).toFloat());
+
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    // render without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication::setAttribute(Qt::AA_Use96Dpi, true);
+    QApplication a(argc, argv);
+
+    Options options = parseOptions(a);
+
+    std::vector<QByteArray> lines = loadTranscript(options.transcriptPath);
+    if (lines.empty()) {
+        qDebug() << "No messages to replay";
+        return 1;
+    }
+
+    initializeHeadlessApplication(argc, argv);
+    auto app = getApp();
+    auto server = app->twitch.server;
+
+    // join every channel that appears in the transcript before measuring anything
+    std::set<QString> channelNames;
+    for (const QByteArray &line : lines) {
+        auto message = Communi::IrcMessage::fromData(line, nullptr);
+        QString target = message->parameters().value(0);
+        if (target.startsWith('#')) {
+            channelNames.insert(target.mid(1));
+        }
+        delete message;
+    }
+
+    StageTimings parseTimings("parse");
+    StageTimings dispatchTimings("dispatch");
+    StageTimings layoutTimings("layout");
+    StageTimings totalTimings("total");
+
+    auto flags = app->settings->getWordFlags();
+    QElapsedTimer layoutTimer;
+    int64_t layoutTime = 0;
+
+    std::vector<ChannelPtr> channels;
+    std::vector<std::deque<MessageLayoutPtr>> layouts(channelNames.size());
+
+    for (const QString &name : channelNames) {
+        ChannelPtr channel = server->getOrAddChannel(name);
+        auto &channelLayouts = layouts[channels.size()];
+
+        // what ChannelView does for every appended message
+        channel->messageAppended.connect([&](auto &message) {
+            layoutTimer.start();
+
+            auto layout = std::make_shared<MessageLayout>(message);
+            layout->layout(options.width, options.scale, flags);
+
+            channelLayouts.push_back(layout);
+            if (channelLayouts.size() > maxLayoutsPerChannel) {
+                channelLayouts.pop_front();
+            }
+
+            layoutTime += layoutTimer.nsecsElapsed();
+        });
+
+        channels.push_back(channel);
+    }
+
+    a.processEvents();
+
+    qDebug().noquote() << QString("Replaying %1 lines %2 times into %3 channels at %4")
+                              .arg(lines.size())
+                              .arg(options.loops)
+                              .arg(channels.size())
+                              .arg(options.rate > 0 ? QString::number(options.rate) + " msg/s"
+                                                    : QString("full speed"));
+
+    size_t messageCount = lines.size() * size_t(options.loops);
+    uint64_t allocationsBefore = getAllocationCount();
+
+    QElapsedTimer wallTimer;
+    QElapsedTimer stageTimer;
+    wallTimer.start();
+
+    for (size_t i = 0; i < messageCount; i++) {
+        if (options.rate > 0) {
+            // wait until this message is due, handling events in the meantime
+            auto due = qint64(i * 1000000000.0 / options.rate);
+            while (wallTimer.nsecsElapsed() < due) {
+                a.processEvents();
+                QThread::usleep(100);
+            }
+        } else if (i % 64 == 0) {
+            a.processEvents();
+        }
+
+        stageTimer.start();
+
+        // parsed without a parent like the server does, addFakeMessage deletes it
+        auto message = Communi::IrcMessage::fromData(lines[i % lines.size()], nullptr);
+        int64_t parseTime = stageTimer.nsecsElapsed();
+
+        layoutTime = 0;
+        server->addFakeMessage(message);
+        int64_t totalTime = stageTimer.nsecsElapsed();
+
+        parseTimings.add(parseTime);
+        dispatchTimings.add(totalTime - parseTime - layoutTime);
+        layoutTimings.add(layoutTime);
+        totalTimings.add(totalTime);
+    }
+
+    a.processEvents();
+
+    double wallSeconds = wallTimer.nsecsElapsed() / 1e9;
+    double busySeconds = totalTimings.getTotal() / 1e9;
+    uint64_t allocations = getAllocationCount() - allocationsBefore;
+
+    qDebug().noquote() << QString("%1 messages in %2s, %3 msg/s wall, %4 msg/s busy")
+                              .arg(messageCount)
+                              .arg(wallSeconds, 0, 'f', 3)
+                              .arg(messageCount / wallSeconds, 0, 'f', 0)
+                              .arg(messageCount / busySeconds, 0, 'f', 0);
+
+    parseTimings.print();
+    dispatchTimings.print();
+    layoutTimings.print();
+    totalTimings.print();
+
+    qDebug().noquote() << QString("allocations: %1 per message")
+                              .arg(double(allocations) / messageCount, 0, 'f', 1);
+    qDebug().noquote() << QString("peak rss: %1 KiB").arg(getPeakRSS());
+
+    // the singletons are never destroyed, same as in the application
+    _exit(0);
+}
@@ -0,0 +1,14 @@
+# Replays a recorded IRC transcript through TwitchServer, TwitchMessageBuilder, Channel and
+# MessageLayout without connecting to anything. See main.cpp for the available options.
+
+include(../../chatterino.pri)
+include(../common/common.pri)
+
+TARGET     = replay-benchmark
+TEMPLATE   = app
+CONFIG    += console
+CONFIG    -= app_bundle
+DEFINES   += BENCHMARK_RESOURCES_DIR=\\\"$$PWD/../resources\\\"
+
+SOURCES += \
+    main.cpp
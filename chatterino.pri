@@ -0,0 +1,408 @@
+# Shared between chatterino.pro and the benchmarks in benchmarks/.
+# Contains everything needed to build the application except for its entry point.
+QT                += widgets core gui network multimedia svg
+CONFIG            += communi
+COMMUNI           += core model util
+CONFIG            += c++14
+INCLUDEPATH       += $$PWD/src/
+DEFINES           += QT_DEPRECATED_WARNINGS
+PRECOMPILED_HEADER = $$PWD/src/precompiled_header.hpp
+CONFIG            += precompile_header
+
+# Submodules
+include(dependencies/rapidjson.pri)
+include(dependencies/settings.pri)
+include(dependencies/signals.pri)
+include(dependencies/humanize.pri)
+include(dependencies/fmt.pri)
+DEFINES += IRC_NAMESPACE=Communi
+include(dependencies/libcommuni.pri)
+include(dependencies/websocketpp.pri)
+include(dependencies/openssl.pri)
+include(dependencies/boost.pri)
+
+# Optional feature: QtWebEngine
+exists ($(QTDIR)/include/QtWebEngine/QtWebEngine) {
+    message(Using QWebEngine)
+    QT += webenginewidgets
+    DEFINES += "USEWEBENGINE"
+}
+
+win32 {
+    LIBS += -luser32
+}
+
+# OSX include directory
+macx {
+    INCLUDEPATH += /usr/local/include
+}
+
+# Optional dependency on Windows SDK 7
+!contains(QMAKE_TARGET.arch, x86_64) {
+    win32:exists(C:\Program Files\Microsoft SDKs\Windows\v7.1\Include\Windows.h) {
+        LIBS += -L"C:\Program Files\Microsoft SDKs\Windows\v7.1\Lib" \
+            -ldwmapi
+
+        DEFINES += "USEWINSDK"
+        message(Using Windows SDK 7)
+    }
+}
+
+# Optional dependency on Windows SDK 10
+contains(QMAKE_TARGET.arch, x86_64) {
+    WIN_SDK_VERSION = $$(WindowsSDKVersion)
+    !isEmpty(WIN_SDK_VERSION) {
+        !equals(WIN_SDK_VERSION, "\\") {
+            DEFINES += "USEWINSDK"
+            message(Using Windows SDK 10)
+        }
+    }
+}
+
+werr {
+    QMAKE_CXXFLAGS += -Werror
+
+    message("Enabling error on warning")
+}
+
+# src
+SOURCES += \
+    $$PWD/src/application.cpp \
+    $$PWD/src/channel.cpp \
+    $$PWD/src/channelstatistics.cpp \
+    $$PWD/src/channeldata.cpp \
+    $$PWD/src/messages/image.cpp \
+    $$PWD/src/messages/layouts/messagelayout.cpp \
+    $$PWD/src/messages/layouts/messagelayoutcontainer.cpp \
+    $$PWD/src/messages/layouts/messagelayoutelement.cpp \
+    $$PWD/src/messages/link.cpp \
+    $$PWD/src/messages/linkparser.cpp \
+    $$PWD/src/messages/message.cpp \
+    $$PWD/src/messages/messagebuilder.cpp \
+    $$PWD/src/messages/messagecolor.cpp \
+    $$PWD/src/messages/messageelement.cpp \
+    $$PWD/src/messages/messageindex.cpp \
+    $$PWD/src/messages/searchquery.cpp \
+    $$PWD/src/providers/irc/abstractircserver.cpp \
+    $$PWD/src/providers/twitch/ircmessagehandler.cpp \
+    $$PWD/src/providers/twitch/twitchaccount.cpp \
+    $$PWD/src/providers/twitch/twitchaccountmanager.cpp \
+    $$PWD/src/providers/twitch/twitchchannel.cpp \
+    $$PWD/src/providers/twitch/twitchmessagebuilder.cpp \
+    $$PWD/src/providers/twitch/twitchserver.cpp \
+    $$PWD/src/providers/twitch/pubsub.cpp \
+    $$PWD/src/singletons/accountmanager.cpp \
+    $$PWD/src/singletons/commandmanager.cpp \
+    $$PWD/src/singletons/emotemanager.cpp \
+    $$PWD/src/singletons/fontmanager.cpp \
+    $$PWD/src/util/completionmodel.cpp \
+    $$PWD/src/singletons/helper/loggingchannel.cpp \
+    $$PWD/src/singletons/helper/logwriter.cpp \
+    $$PWD/src/singletons/helper/structuredlog.cpp \
+    $$PWD/src/singletons/helper/structuredloggingchannel.cpp \
+    $$PWD/src/singletons/helper/moderationaction.cpp \
+    $$PWD/src/singletons/helper/chatterinosetting.cpp \
+    $$PWD/src/singletons/loggingmanager.cpp \
+    $$PWD/src/singletons/pathmanager.cpp \
+    $$PWD/src/singletons/resourcemanager.cpp \
+    $$PWD/src/singletons/settingsmanager.cpp \
+    $$PWD/src/singletons/thememanager.cpp \
+    $$PWD/src/singletons/windowmanager.cpp \
+    $$PWD/src/util/networkmanager.cpp \
+    $$PWD/src/util/networkrequest.cpp \
+    $$PWD/src/widgets/accountpopup.cpp \
+    $$PWD/src/widgets/accountswitchpopupwidget.cpp \
+    $$PWD/src/widgets/accountswitchwidget.cpp \
+    $$PWD/src/widgets/basewidget.cpp \
+    $$PWD/src/widgets/basewindow.cpp \
+    $$PWD/src/widgets/emotepopup.cpp \
+    $$PWD/src/widgets/helper/channelview.cpp \
+    $$PWD/src/widgets/helper/droppreview.cpp \
+    $$PWD/src/widgets/helper/label.cpp \
+    $$PWD/src/widgets/helper/notebookbutton.cpp \
+    $$PWD/src/widgets/helper/notebooktab.cpp \
+    $$PWD/src/widgets/helper/resizingtextedit.cpp \
+    $$PWD/src/widgets/helper/rippleeffectbutton.cpp \
+    $$PWD/src/widgets/helper/rippleeffectlabel.cpp \
+    $$PWD/src/widgets/helper/scrollbarhighlight.cpp \
+    $$PWD/src/widgets/helper/searchpopup.cpp \
+    $$PWD/src/widgets/helper/settingsdialogtab.cpp \
+    $$PWD/src/widgets/helper/splitcolumn.cpp \
+    $$PWD/src/widgets/helper/splitheader.cpp \
+    $$PWD/src/widgets/helper/splitinput.cpp \
+    $$PWD/src/widgets/helper/titlebarbutton.cpp \
+    $$PWD/src/widgets/logindialog.cpp \
+    $$PWD/src/widgets/notebook.cpp \
+    $$PWD/src/widgets/qualitypopup.cpp \
+    $$PWD/src/widgets/scrollbar.cpp \
+    $$PWD/src/widgets/settingsdialog.cpp \
+    $$PWD/src/widgets/settingspages/aboutpage.cpp \
+    $$PWD/src/widgets/settingspages/accountspage.cpp \
+    $$PWD/src/widgets/settingspages/appearancepage.cpp \
+    $$PWD/src/widgets/settingspages/behaviourpage.cpp \
+    $$PWD/src/widgets/settingspages/commandpage.cpp \
+    $$PWD/src/widgets/settingspages/emotespage.cpp \
+    $$PWD/src/widgets/settingspages/highlightingpage.cpp \
+    $$PWD/src/widgets/settingspages/ignoremessagespage.cpp \
+    $$PWD/src/widgets/settingspages/ignoreuserspage.cpp \
+    $$PWD/src/widgets/settingspages/keyboardsettingspage.cpp \
+    $$PWD/src/widgets/settingspages/logspage.cpp \
+    $$PWD/src/widgets/settingspages/moderationpage.cpp \
+    $$PWD/src/widgets/settingspages/settingspage.cpp \
+    $$PWD/src/widgets/settingspages/specialchannelspage.cpp \
+    $$PWD/src/widgets/split.cpp \
+    $$PWD/src/widgets/splitcontainer.cpp \
+    $$PWD/src/widgets/streamview.cpp \
+    $$PWD/src/widgets/textinputdialog.cpp \
+    $$PWD/src/widgets/tooltipwidget.cpp \
+    $$PWD/src/widgets/window.cpp \
+    $$PWD/src/providers/irc/ircaccount.cpp \
+    $$PWD/src/providers/irc/ircserver.cpp \
+    $$PWD/src/providers/irc/ircchannel2.cpp \
+    $$PWD/src/providers/irc/joinscheduler.cpp \
+    $$PWD/src/providers/irc/sendqueue.cpp \
+    $$PWD/src/util/streamlink.cpp \
+    $$PWD/src/providers/twitch/twitchhelpers.cpp \
+    $$PWD/src/widgets/helper/signallabel.cpp \
+    $$PWD/src/widgets/helper/debugpopup.cpp \
+    $$PWD/src/widgets/helper/performanceoverlay.cpp \
+    $$PWD/src/util/metrics.cpp \
+    $$PWD/src/util/tracing.cpp \
+    $$PWD/src/singletons/nativemessagingmanager.cpp \
+    $$PWD/src/util/rapidjson-helpers.cpp \
+    $$PWD/src/providers/twitch/pubsubhelpers.cpp \
+    $$PWD/src/providers/twitch/pubsubactions.cpp \
+    $$PWD/src/providers/twitch/twitchuser.cpp \
+    $$PWD/src/widgets/selectchanneldialog.cpp \
+    $$PWD/src/singletons/updatemanager.cpp \
+    $$PWD/src/widgets/lastruncrashdialog.cpp \
+    $$PWD/src/widgets/attachedwindow.cpp \
+    $$PWD/src/widgets/settingspages/externaltoolspage.cpp \
+    $$PWD/src/widgets/helper/comboboxitemdelegate.cpp \
+    $$PWD/src/util/signalvectormodel.cpp \
+    $$PWD/src/controllers/commands/command.cpp \
+    $$PWD/src/controllers/commands/commandmodel.cpp \
+    $$PWD/src/controllers/commands/commandcontroller.cpp \
+    $$PWD/src/controllers/highlights/highlightcontroller.cpp \
+    $$PWD/src/controllers/highlights/highlightmodel.cpp \
+    $$PWD/src/widgets/helper/editablemodelview.cpp \
+    $$PWD/src/controllers/accounts/accountcontroller.cpp \
+    $$PWD/src/controllers/accounts/accountmodel.cpp \
+    $$PWD/src/controllers/accounts/account.cpp \
+    $$PWD/src/widgets/helper/splitoverlay.cpp
+
+HEADERS  += \
+    $$PWD/src/precompiled_header.hpp \
+    $$PWD/src/channel.hpp \
+    $$PWD/src/channelstatistics.hpp \
+    $$PWD/src/const.hpp \
+    $$PWD/src/debug/log.hpp \
+    $$PWD/src/emojis.hpp \
+    $$PWD/src/messages/image.hpp \
+    $$PWD/src/messages/layouts/messagelayout.hpp \
+    $$PWD/src/messages/layouts/messagelayoutcontainer.hpp \
+    $$PWD/src/messages/layouts/messagelayoutelement.hpp \
+    $$PWD/src/messages/limitedqueue.hpp \
+    $$PWD/src/messages/limitedqueuesnapshot.hpp \
+    $$PWD/src/messages/link.hpp \
+    $$PWD/src/messages/linkparser.hpp \
+    $$PWD/src/messages/tldtable.hpp \
+    $$PWD/src/messages/message.hpp \
+    $$PWD/src/messages/messagebuilder.hpp \
+    $$PWD/src/messages/messagecolor.hpp \
+    $$PWD/src/messages/messageelement.hpp \
+    $$PWD/src/messages/messageindex.hpp \
+    $$PWD/src/messages/messageparseargs.hpp \
+    $$PWD/src/messages/searchquery.hpp \
+    $$PWD/src/messages/selection.hpp \
+    $$PWD/src/providers/twitch/emotevalue.hpp \
+    $$PWD/src/providers/twitch/ircmessagehandler.hpp \
+    $$PWD/src/providers/twitch/twitchaccount.hpp \
+    $$PWD/src/providers/twitch/twitchaccountmanager.hpp \
+    $$PWD/src/providers/twitch/twitchchannel.hpp \
+    $$PWD/src/providers/twitch/twitchmessagebuilder.hpp \
+    $$PWD/src/providers/twitch/twitchserver.hpp \
+    $$PWD/src/providers/twitch/pubsub.hpp \
+    $$PWD/src/singletons/accountmanager.hpp \
+    $$PWD/src/singletons/commandmanager.hpp \
+    $$PWD/src/singletons/emotemanager.hpp \
+    $$PWD/src/singletons/fontmanager.hpp \
+    $$PWD/src/singletons/helper/chatterinosetting.hpp \
+    $$PWD/src/util/completionmodel.hpp \
+    $$PWD/src/singletons/helper/loggingchannel.hpp \
+    $$PWD/src/singletons/helper/logwriter.hpp \
+    $$PWD/src/singletons/helper/structuredlog.hpp \
+    $$PWD/src/singletons/helper/structuredloggingchannel.hpp \
+    $$PWD/src/singletons/helper/moderationaction.hpp \
+    $$PWD/src/singletons/loggingmanager.hpp \
+    $$PWD/src/singletons/pathmanager.hpp \
+    $$PWD/src/singletons/resourcemanager.hpp \
+    $$PWD/src/singletons/thememanager.hpp \
+    $$PWD/src/singletons/windowmanager.hpp \
+    $$PWD/src/util/benchmark.hpp \
+    $$PWD/src/util/concurrentmap.hpp \
+    $$PWD/src/util/distancebetweenpoints.hpp \
+    $$PWD/src/util/emotemap.hpp \
+    $$PWD/src/util/flagsenum.hpp \
+    $$PWD/src/util/helpers.hpp \
+    $$PWD/src/util/irchelpers.hpp \
+    $$PWD/src/util/layoutcreator.hpp \
+    $$PWD/src/util/nativeeventhelper.hpp \
+    $$PWD/src/util/networkmanager.hpp \
+    $$PWD/src/util/networkrequest.hpp \
+    $$PWD/src/util/networkrequester.hpp \
+    $$PWD/src/util/networkworker.hpp \
+    $$PWD/src/util/posttothread.hpp \
+    $$PWD/src/util/property.hpp \
+    $$PWD/src/util/serialize-custom.hpp \
+    $$PWD/src/util/spscqueue.hpp \
+    $$PWD/src/util/urlfetch.hpp \
+    $$PWD/src/widgets/accountpopup.hpp \
+    $$PWD/src/widgets/accountswitchpopupwidget.hpp \
+    $$PWD/src/widgets/accountswitchwidget.hpp \
+    $$PWD/src/widgets/basewidget.hpp \
+    $$PWD/src/widgets/basewindow.hpp \
+    $$PWD/src/widgets/emotepopup.hpp \
+    $$PWD/src/widgets/helper/channelview.hpp \
+    $$PWD/src/widgets/helper/droppreview.hpp \
+    $$PWD/src/widgets/helper/label.hpp \
+    $$PWD/src/widgets/helper/notebookbutton.hpp \
+    $$PWD/src/widgets/helper/notebooktab.hpp \
+    $$PWD/src/widgets/helper/resizingtextedit.hpp \
+    $$PWD/src/widgets/helper/rippleeffectbutton.hpp \
+    $$PWD/src/widgets/helper/rippleeffectlabel.hpp \
+    $$PWD/src/widgets/helper/scrollbarhighlight.hpp \
+    $$PWD/src/widgets/helper/searchpopup.hpp \
+    $$PWD/src/widgets/helper/settingsdialogtab.hpp \
+    $$PWD/src/widgets/helper/shortcut.hpp \
+    $$PWD/src/widgets/helper/signallabel.hpp \
+    $$PWD/src/widgets/helper/splitcolumn.hpp \
+    $$PWD/src/widgets/helper/splitheader.hpp \
+    $$PWD/src/widgets/helper/splitinput.hpp \
+    $$PWD/src/widgets/helper/titlebarbutton.hpp \
+    $$PWD/src/widgets/notebook.hpp \
+    $$PWD/src/widgets/qualitypopup.hpp \
+    $$PWD/src/widgets/scrollbar.hpp \
+    $$PWD/src/widgets/settingsdialog.hpp \
+    $$PWD/src/widgets/settingspages/aboutpage.hpp \
+    $$PWD/src/widgets/settingspages/accountspage.hpp \
+    $$PWD/src/widgets/settingspages/appearancepage.hpp \
+    $$PWD/src/widgets/settingspages/behaviourpage.hpp \
+    $$PWD/src/widgets/settingspages/commandpage.hpp \
+    $$PWD/src/widgets/settingspages/emotespage.hpp \
+    $$PWD/src/widgets/settingspages/highlightingpage.hpp \
+    $$PWD/src/widgets/settingspages/ignoremessagespage.hpp \
+    $$PWD/src/widgets/settingspages/ignoreuserspage.hpp \
+    $$PWD/src/widgets/settingspages/keyboardsettingspage.hpp \
+    $$PWD/src/widgets/settingspages/logspage.hpp \
+    $$PWD/src/widgets/settingspages/moderationpage.hpp \
+    $$PWD/src/widgets/settingspages/settingspage.hpp \
+    $$PWD/src/widgets/settingspages/specialchannelspage.hpp \
+    $$PWD/src/widgets/split.hpp \
+    $$PWD/src/widgets/splitcontainer.hpp \
+    $$PWD/src/widgets/streamview.hpp \
+    $$PWD/src/widgets/textinputdialog.hpp \
+    $$PWD/src/widgets/tooltipwidget.hpp \
+    $$PWD/src/widgets/window.hpp \
+    $$PWD/src/common.hpp \
+    $$PWD/src/providers/irc/abstractircserver.hpp \
+    $$PWD/src/providers/irc/ircaccount.hpp \
+    $$PWD/src/providers/irc/ircserver.hpp \
+    $$PWD/src/providers/irc/ircchannel2.hpp \
+    $$PWD/src/providers/irc/joinscheduler.hpp \
+    $$PWD/src/providers/irc/sendqueue.hpp \
+    $$PWD/src/util/streamlink.hpp \
+    $$PWD/src/providers/twitch/twitchhelpers.hpp \
+    $$PWD/src/util/metrics.hpp \
+    $$PWD/src/util/tracing.hpp \
+    $$PWD/src/widgets/helper/debugpopup.hpp \
+    $$PWD/src/widgets/helper/performanceoverlay.hpp \
+    $$PWD/src/version.hpp \
+    $$PWD/src/singletons/settingsmanager.hpp \
+    $$PWD/src/singletons/nativemessagingmanager.hpp \
+    $$PWD/src/util/rapidjson-helpers.hpp \
+    $$PWD/src/providers/twitch/pubsubhelpers.hpp \
+    $$PWD/src/providers/twitch/pubsubactions.hpp \
+    $$PWD/src/providers/twitch/twitchuser.hpp \
+    $$PWD/src/widgets/selectchanneldialog.hpp \
+    $$PWD/src/singletons/updatemanager.hpp \
+    $$PWD/src/widgets/lastruncrashdialog.hpp \
+    $$PWD/src/widgets/attachedwindow.hpp \
+    $$PWD/src/widgets/settingspages/externaltoolspage.hpp \
+    $$PWD/src/util/removescrollareabackground.hpp \
+    $$PWD/src/util/standarditemhelper.hpp \
+    $$PWD/src/widgets/helper/comboboxitemdelegate.hpp \
+    $$PWD/src/util/assertinguithread.hpp \
+    $$PWD/src/util/signalvector2.hpp \
+    $$PWD/src/util/signalvectormodel.hpp \
+    $$PWD/src/controllers/commands/command.hpp \
+    $$PWD/src/controllers/commands/commandmodel.hpp \
+    $$PWD/src/controllers/commands/commandcontroller.hpp \
+    $$PWD/src/controllers/highlights/highlightcontroller.hpp \
+    $$PWD/src/controllers/highlights/highlightphrase.hpp \
+    $$PWD/src/controllers/highlights/highlightmodel.hpp \
+    $$PWD/src/widgets/helper/editablemodelview.hpp \
+    $$PWD/src/controllers/accounts/accountcontroller.hpp \
+    $$PWD/src/controllers/accounts/accountmodel.hpp \
+    $$PWD/src/controllers/accounts/account.hpp \
+    $$PWD/src/util/sharedptrelementless.hpp \
+    $$PWD/src/widgets/helper/splitoverlay.hpp
+
+RESOURCES += \
+    $$PWD/resources/resources.qrc
+
+DISTFILES +=
+
+FORMS += \
+    $$PWD/forms/accountpopupform.ui
+
+# Define warning flags for Chatterino
+win32-msvc* {
+    QMAKE_CXXFLAGS_WARN_ON = /W4
+    # 4714 - function marked as __forceinline not inlined
+    # 4996 - occurs when the compiler encounters a function or variable that is marked as deprecated.
+    #        These functions may have a different preferred name, may be insecure or have
+    #        a more secure variant, or may be obsolete.
+    # 4505 - unreferenced local version has been removed
+    # 4127 - conditional expression is constant
+    # 4503 - decorated name length exceeded, name was truncated
+    # 4100 - unreferences formal parameter
+    # 4305 - possible truncation of data
+    # 4267 - possible loss of data in return
+    QMAKE_CXXFLAGS_WARN_ON += /wd4714
+    QMAKE_CXXFLAGS_WARN_ON += /wd4996
+    QMAKE_CXXFLAGS_WARN_ON += /wd4505
+    QMAKE_CXXFLAGS_WARN_ON += /wd4127
+    QMAKE_CXXFLAGS_WARN_ON += /wd4503
+    QMAKE_CXXFLAGS_WARN_ON += /wd4100
+    QMAKE_CXXFLAGS_WARN_ON += /wd4305
+    QMAKE_CXXFLAGS_WARN_ON += /wd4267
+
+} else {
+    QMAKE_CXXFLAGS_WARN_ON = -Wall
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-function
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-switch
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-deprecated-declarations
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-sign-compare
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-variable
+
+    # Disabling strict-aliasing warnings for now, although we probably want to re-enable this in the future
+    QMAKE_CXXFLAGS_WARN_ON += -Wno-strict-aliasing
+
+    equals(QMAKE_CXX, "clang++") {
+        QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-local-typedef
+    } else {
+        QMAKE_CXXFLAGS_WARN_ON += -Wno-class-memaccess
+    }
+}
+
+# do not use windows min/max macros
+#win32 {
+#    DEFINES += NOMINMAX
+#}
+
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+linux {
+    QMAKE_LFLAGS += -lrt
+}
@@ -226,6 +226,8 @@ void Application::save()
     this->windows->save();
 
     this->commands->save();
+
+    this->logging->flush();
 }
 
 void Application::runNativeMessagingHost()
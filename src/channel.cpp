@@ -7,6 +7,7 @@
 #include "singletons/ircmanager.hpp"
 #include "singletons/loggingmanager.hpp"
 #include "singletons/windowmanager.hpp"
+#include "util/tracing.hpp"
 
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -16,6 +17,8 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 
+#include <algorithm>
+
 using namespace chatterino::messages;
 
 namespace chatterino {
@@ -57,20 +60,25 @@ messages::LimitedQueueSnapshot<messages::MessagePtr> Channel::getMessageSnapshot
 
 void Channel::addMessage(MessagePtr message)
 {
+    util::tracing::Scope trace(util::tracing::Stage::AddMessage);
+
     auto app = getApp();
     MessagePtr deleted;
 
     bool isTimeout = (message->flags & Message::Timeout) != 0;
 
-    if (!isTimeout) {
-        const QString &username = message->loginName;
-        if (!username.isEmpty()) {
-            // TODO: Add recent chatters display name. This should maybe be a setting
-            this->addRecentChatter(message);
+    // channels without a type only display messages of other channels, e.g. search results
+    if (this->type != None) {
+        if (!isTimeout) {
+            const QString &username = message->loginName;
+            if (!username.isEmpty()) {
+                // TODO: Add recent chatters display name. This should maybe be a setting
+                this->addRecentChatter(message);
+            }
         }
-    }
 
-    app->logging->addMessage(this->name, message);
+        app->logging->addMessage(this->name, message);
+    }
 
     if (isTimeout) {
         LimitedQueueSnapshot<MessagePtr> snapshot = this->getMessageSnapshot();
@@ -111,7 +119,12 @@ void Channel::addMessage(MessagePtr message)
         }
     }
 
-    if (this->messages.pushBack(message, deleted)) {
+    bool removed = this->messages.pushBack(message, deleted);
+
+    this->trackMessage(message);
+
+    if (removed) {
+        this->untrackMessage(deleted);
         this->messageRemovedFromStart.invoke(deleted);
     }
 
@@ -122,20 +135,162 @@ void Channel::addMessagesAtStart(std::vector<messages::MessagePtr> &_messages)
 {
     std::vector<messages::MessagePtr> addedMessages = this->messages.pushFront(_messages);
 
+    for (const MessagePtr &message : addedMessages) {
+        this->trackMessage(message);
+    }
+
     if (addedMessages.size() != 0) {
         this->messagesAddedAtStart.invoke(addedMessages);
     }
 }
 
+void Channel::fillInMissingMessages(const std::vector<messages::MessagePtr> &_messages)
+{
+    std::vector<MessagePtr> missing;
+    for (const MessagePtr &message : _messages) {
+        if (message->id.isEmpty() || !this->messageIds.contains(message->id)) {
+            missing.push_back(message);
+        }
+    }
+
+    if (missing.empty()) {
+        return;
+    }
+
+    std::stable_sort(missing.begin(), missing.end(), [](const auto &a, const auto &b) {
+        return a->serverReceivedTime < b->serverReceivedTime;
+    });
+
+    // group the messages by the index they are inserted at, searching from the end since missed
+    // messages are usually recent
+    auto snapshot = this->getMessageSnapshot();
+    std::vector<std::pair<size_t, std::vector<MessagePtr>>> groups;
+    size_t index = snapshot.getLength();
+
+    for (auto it = missing.rbegin(); it != missing.rend(); ++it) {
+        while (index > 0 && snapshot[index - 1]->serverReceivedTime > (*it)->serverReceivedTime) {
+            index--;
+        }
+
+        if (groups.empty() || groups.back().first != index) {
+            groups.emplace_back(index, std::vector<MessagePtr>());
+        }
+        groups.back().second.push_back(*it);
+    }
+
+    // insert the last group first so the indices of the others stay valid, except for messages
+    // that were removed from the start
+    size_t removedCount = 0;
+
+    for (auto &group : groups) {
+        std::reverse(group.second.begin(), group.second.end());
+
+        size_t groupIndex = group.first > removedCount ? group.first - removedCount : 0;
+        std::vector<MessagePtr> removed = this->messages.insert(groupIndex, group.second);
+        removedCount += removed.size();
+
+        for (const MessagePtr &message : group.second) {
+            this->trackMessage(message);
+        }
+
+        this->messagesInserted.invoke(groupIndex, group.second);
+
+        for (MessagePtr &message : removed) {
+            this->untrackMessage(message);
+            this->messageRemovedFromStart.invoke(message);
+        }
+    }
+}
+
 void Channel::replaceMessage(messages::MessagePtr message, messages::MessagePtr replacement)
 {
     int index = this->messages.replaceItem(message, replacement);
 
     if (index >= 0) {
+        this->untrackMessage(message);
+        this->trackMessage(replacement);
+
         this->messageReplaced.invoke((size_t)index, replacement);
     }
 }
 
+void Channel::resetMessages(const std::vector<messages::MessagePtr> &_messages)
+{
+    auto snapshot = this->getMessageSnapshot();
+
+    this->messages.clear();
+
+    for (size_t i = 0; i < snapshot.getLength(); i++) {
+        this->untrackMessage(snapshot[i]);
+    }
+
+    std::vector<MessagePtr> addedMessages = this->messages.pushFront(_messages);
+
+    for (const MessagePtr &message : addedMessages) {
+        this->trackMessage(message);
+    }
+
+    this->messagesReset.invoke(addedMessages);
+}
+
+void Channel::trackMessage(const messages::MessagePtr &message)
+{
+    if (!message->id.isEmpty()) {
+        this->messageIds.insert(message->id);
+    }
+
+    std::lock_guard<std::mutex> lock(this->searchIndexMutex);
+
+    if (this->searchIndex) {
+        this->searchIndex->add(message);
+    }
+}
+
+void Channel::untrackMessage(const messages::MessagePtr &message)
+{
+    if (!message) {
+        return;
+    }
+
+    if (!message->id.isEmpty()) {
+        this->messageIds.remove(message->id);
+    }
+
+    std::lock_guard<std::mutex> lock(this->searchIndexMutex);
+
+    if (this->searchIndex) {
+        this->searchIndex->remove(message);
+    }
+}
+
+std::vector<messages::MessagePtr> Channel::search(const messages::SearchQuery &query)
+{
+    std::lock_guard<std::mutex> lock(this->searchIndexMutex);
+
+    return this->getSearchIndex().search(query);
+}
+
+std::vector<messages::MessagePtr> Channel::findSearchCandidates(const messages::SearchQuery &query)
+{
+    std::lock_guard<std::mutex> lock(this->searchIndexMutex);
+
+    return this->getSearchIndex().findCandidates(query);
+}
+
+messages::MessageIndex &Channel::getSearchIndex()
+{
+    if (!this->searchIndex) {
+        this->searchIndex.reset(new MessageIndex);
+
+        auto snapshot = this->getMessageSnapshot();
+        for (size_t i = 0; i < snapshot.getLength(); i++) {
+            this->searchIndex->add(snapshot[i]);
+        }
+    }
+
+    return *this->searchIndex;
+}
+
 void Channel::addRecentChatter(const std::shared_ptr<messages::Message> &message)
 {
     // Do nothing by default
@@ -1,16 +1,21 @@
 #pragma once
 
+#include "channelstatistics.hpp"
 #include "messages/image.hpp"
 #include "messages/limitedqueue.hpp"
 #include "messages/message.hpp"
+#include "messages/messageindex.hpp"
+#include "messages/searchquery.hpp"
 #include "util/completionmodel.hpp"
 #include "util/concurrentmap.hpp"
 
+#include <QSet>
 #include <QString>
 #include <QTimer>
 #include <pajlada/signals/signal.hpp>
 
 #include <memory>
+#include <mutex>
 
 namespace chatterino {
 namespace messages {
@@ -39,7 +44,9 @@ public:
     pajlada::Signals::Signal<messages::MessagePtr &> messageRemovedFromStart;
     pajlada::Signals::Signal<messages::MessagePtr &> messageAppended;
     pajlada::Signals::Signal<std::vector<messages::MessagePtr> &> messagesAddedAtStart;
+    pajlada::Signals::Signal<size_t, std::vector<messages::MessagePtr> &> messagesInserted;
     pajlada::Signals::Signal<size_t, messages::MessagePtr &> messageReplaced;
+    pajlada::Signals::Signal<std::vector<messages::MessagePtr> &> messagesReset;
     pajlada::Signals::NoArgSignal destroyed;
 
     Type getType() const;
@@ -48,9 +55,20 @@ public:
 
     void addMessage(messages::MessagePtr message);
     void addMessagesAtStart(std::vector<messages::MessagePtr> &messages);
+    // Inserts messages that were missed, e.g. while disconnected, by the time they were sent.
+    // Messages the channel already contains are skipped.
+    void fillInMissingMessages(const std::vector<messages::MessagePtr> &messages);
     void replaceMessage(messages::MessagePtr message, messages::MessagePtr replacement);
+    // Replaces all messages of the channel, e.g. with new search results. Views keep the layouts
+    // of the messages that stay.
+    void resetMessages(const std::vector<messages::MessagePtr> &messages);
     virtual void addRecentChatter(const std::shared_ptr<messages::Message> &message);
 
+    // The messages of the channel that match the query, oldest first. The index is built on the
+    // first search and kept up to date from then on. Both can be called from any thread.
+    std::vector<messages::MessagePtr> search(const messages::SearchQuery &query);
+    std::vector<messages::MessagePtr> findSearchCandidates(const messages::SearchQuery &query);
+
     QString name;
     QStringList modList;
 
@@ -62,12 +80,29 @@ public:
 
     CompletionModel completionModel;
 
+    ChannelStatistics statistics;
+
 protected:
     virtual void onConnected();
 
 private:
+    // keep the ids and the search index in sync with the messages, called after the messages
+    // changed so an index that is built meanwhile from a snapshot doesn't miss any
+    void trackMessage(const messages::MessagePtr &message);
+    void untrackMessage(const messages::MessagePtr &message);
+
+    // searchIndexMutex has to be locked
+    messages::MessageIndex &getSearchIndex();
+
     messages::LimitedQueue<messages::MessagePtr> messages;
     Type type;
+
+    // ids of the messages in the channel, gui thread only
+    QSet<QString> messageIds;
+
+    // searches run on worker threads
+    std::unique_ptr<messages::MessageIndex> searchIndex;
+    std::mutex searchIndexMutex;
 };
 
 using ChannelPtr = std::shared_ptr<Channel>;
@@ -0,0 +1,92 @@
+#include "channelstatistics.hpp"
+
+#include <QDateTime>
+
+namespace chatterino {
+
+namespace {
+
+int64_t currentSecond()
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000;
+}
+
+}  // namespace
+
+void ChannelStatistics::addMessage(int _bytes, int64_t _buildNanoseconds, bool highlighted)
+{
+    int64_t second = currentSecond();
+    Bucket &bucket = this->buckets[second % this->buckets.size()];
+
+    // only the receiving thread adds messages, so a bucket is never reset concurrently
+    if (bucket.second.load(std::memory_order_relaxed) != second) {
+        bucket.messages.store(0, std::memory_order_relaxed);
+        bucket.bytes.store(0, std::memory_order_relaxed);
+        bucket.second.store(second, std::memory_order_relaxed);
+    }
+
+    bucket.messages.fetch_add(1, std::memory_order_relaxed);
+    bucket.bytes.fetch_add(_bytes, std::memory_order_relaxed);
+
+    this->messages.fetch_add(1, std::memory_order_relaxed);
+    this->bytes.fetch_add(_bytes, std::memory_order_relaxed);
+    this->buildNanoseconds.fetch_add(_buildNanoseconds, std::memory_order_relaxed);
+
+    if (highlighted) {
+        this->highlights.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ChannelStatistics::addLayoutInvalidations(int count)
+{
+    this->layoutInvalidations.fetch_add(count, std::memory_order_relaxed);
+}
+
+ChannelStatistics::Snapshot ChannelStatistics::getSnapshot() const
+{
+    Snapshot snapshot;
+
+    snapshot.messages = this->messages.load(std::memory_order_relaxed);
+    snapshot.bytes = this->bytes.load(std::memory_order_relaxed);
+    snapshot.highlights = this->highlights.load(std::memory_order_relaxed);
+    snapshot.layoutInvalidations = this->layoutInvalidations.load(std::memory_order_relaxed);
+
+    if (snapshot.messages > 0) {
+        snapshot.averageBuildMicroseconds =
+            this->buildNanoseconds.load(std::memory_order_relaxed) / 1000.0 / snapshot.messages;
+    }
+
+    int64_t second = currentSecond();
+    int64_t windowMessages = 0;
+    int64_t windowBytes = 0;
+
+    for (const Bucket &bucket : this->buckets) {
+        int64_t bucketSecond = bucket.second.load(std::memory_order_relaxed);
+
+        if (bucketSecond < second && bucketSecond >= second - rateWindow) {
+            windowMessages += bucket.messages.load(std::memory_order_relaxed);
+            windowBytes += bucket.bytes.load(std::memory_order_relaxed);
+        }
+    }
+
+    snapshot.messagesPerSecond = double(windowMessages) / rateWindow;
+    snapshot.bytesPerSecond = double(windowBytes) / rateWindow;
+
+    return snapshot;
+}
+
+QString ChannelStatistics::getSummary() const
+{
+    Snapshot snapshot = this->getSnapshot();
+
+    return QString("%1 msg/s, %2 KB/s, %3 us per message, %4 messages, %5 highlights, %6 "
+                   "layout invalidations")
+        .arg(snapshot.messagesPerSecond, 0, 'f', 1)
+        .arg(snapshot.bytesPerSecond / 1024, 0, 'f', 1)
+        .arg(snapshot.averageBuildMicroseconds, 0, 'f', 0)
+        .arg(snapshot.messages)
+        .arg(snapshot.highlights)
+        .arg(snapshot.layoutInvalidations);
+}
+
+}  // namespace chatterino
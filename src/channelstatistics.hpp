@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QString>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace chatterino {
+
+// Throughput and cost of the messages of one channel. Messages are added by the thread that
+// receives them and layout invalidations by the views showing the channel, reading is possible
+// from any thread.
+class ChannelStatistics : boost::noncopyable
+{
+public:
+    struct Snapshot {
+        double messagesPerSecond = 0;
+        double bytesPerSecond = 0;
+        double averageBuildMicroseconds = 0;
+
+        int64_t messages = 0;
+        int64_t bytes = 0;
+        int64_t highlights = 0;
+        int64_t layoutInvalidations = 0;
+    };
+
+    // A message of `bytes` raw bytes was received and took `buildNanoseconds` to build
+    void addMessage(int bytes, int64_t buildNanoseconds, bool highlighted);
+
+    // Messages of the channel had to be laid out again
+    void addLayoutInvalidations(int count);
+
+    Snapshot getSnapshot() const;
+
+    // "12.3 msg/s, 4.5 KB/s, ..." on one line
+    QString getSummary() const;
+
+private:
+    // messages and bytes per second of the last seconds, rates are averaged over the seconds
+    // before the current one
+    static constexpr int64_t rateWindow = 10;
+
+    struct Bucket {
+        std::atomic<int64_t> second{-1};
+        std::atomic<int64_t> messages{0};
+        std::atomic<int64_t> bytes{0};
+    };
+
+    std::array<Bucket, rateWindow + 1> buckets;
+
+    std::atomic<int64_t> messages{0};
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int64_t> buildNanoseconds{0};
+    std::atomic<int64_t> highlights{0};
+    std::atomic<int64_t> layoutInvalidations{0};
+};
+
+}  // namespace chatterino
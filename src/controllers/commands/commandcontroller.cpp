@@ -14,6 +14,8 @@
 #include <QFile>
 #include <QRegularExpression>
 
+#include <algorithm>
+
 using namespace chatterino::providers::twitch;
 
 namespace chatterino {
@@ -117,6 +119,36 @@ QString CommandController::execCommand(const QString &text, ChannelPtr channel,
 
                 channel->addMessage(messages::Message::createSystemMessage(messageText));
 
+                return "";
+            } else if (commandName == "/stats") {
+                if (words.size() >= 2 && words[1] == "all") {
+                    // the busiest channels first
+                    std::vector<std::pair<double, QString>> lines;
+
+                    getApp()->twitch.server->forEachChannel([&lines](ChannelPtr other) {
+                        auto statistics = other->statistics.getSnapshot();
+
+                        lines.emplace_back(statistics.messagesPerSecond,
+                                           other->name + ": " + other->statistics.getSummary());
+                    });
+
+                    std::sort(lines.begin(), lines.end(),
+                              [](const auto &a, const auto &b) { return a.first > b.first; });
+
+                    for (const auto &line : lines) {
+                        channel->addMessage(messages::Message::createSystemMessage(line.second));
+                    }
+
+                    auto server = getApp()->twitch.server;
+                    channel->addMessage(messages::Message::createSystemMessage(
+                        QString("%1 read connections, %2 messages waiting to be sent")
+                            .arg(server->getReadConnectionCount())
+                            .arg(server->getSendQueueSize())));
+                } else {
+                    channel->addMessage(
+                        messages::Message::createSystemMessage(channel->statistics.getSummary()));
+                }
+
                 return "";
             } else if (commandName == "/ignore" && words.size() >= 2) {
                 auto app = getApp();
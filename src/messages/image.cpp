@@ -4,8 +4,10 @@
 #include "singletons/emotemanager.hpp"
 #include "singletons/ircmanager.hpp"
 #include "singletons/windowmanager.hpp"
+#include "util/metrics.hpp"
 #include "util/networkmanager.hpp"
 #include "util/posttothread.hpp"
+#include "util/tracing.hpp"
 #include "util/urlfetch.hpp"
 
 #include <QBuffer>
@@ -21,6 +23,14 @@
 namespace chatterino {
 namespace messages {
 
+namespace {
+
+util::metrics::Counter imageCount("images");
+util::metrics::Counter animatedImageCount("animated images");
+util::metrics::Counter loadedImageCount("loaded images");
+
+}  // namespace
+
 bool Image::loadedEventQueued = false;
 
 Image::Image(const QString &url, qreal scale, const QString &name, const QString &tooltip,
@@ -32,7 +42,7 @@ Image::Image(const QString &url, qreal scale, const QString &name, const QString
     , ishat(isHat)
     , scale(scale)
 {
-    util::DebugCount::increase("images");
+    imageCount.increase();
 }
 
 Image::Image(QPixmap *image, qreal scale, const QString &name, const QString &tooltip,
@@ -46,19 +56,19 @@ Image::Image(QPixmap *image, qreal scale, const QString &name, const QString &to
     , isLoading(true)
     , isLoaded(true)
 {
-    util::DebugCount::increase("images");
+    imageCount.increase();
 }
 
 Image::~Image()
 {
-    util::DebugCount::decrease("images");
+    imageCount.decrease();
 
     if (this->isAnimated()) {
-        util::DebugCount::decrease("animated images");
+        animatedImageCount.decrease();
     }
 
     if (this->isLoaded) {
-        util::DebugCount::decrease("loaded images");
+        loadedImageCount.decrease();
     }
 }
 
@@ -68,6 +78,8 @@ void Image::loadImage()
     req.setCaller(this);
     req.setUseQuickLoadCache(true);
     req.get([this](QByteArray bytes) -> bool {
+        util::tracing::Scope trace(util::tracing::Stage::ImageDecode);
+
         QByteArray copy = QByteArray::fromRawData(bytes.constData(), bytes.length());
         QBuffer buffer(&copy);
         buffer.open(QIODevice::ReadOnly);
@@ -80,10 +92,10 @@ void Image::loadImage()
         // clear stuff before loading the image again
         this->allFrames.clear();
         if (this->isAnimated()) {
-            util::DebugCount::decrease("animated images");
+            animatedImageCount.decrease();
         }
         if (this->isLoaded) {
-            util::DebugCount::decrease("loaded images");
+            loadedImageCount.decrease();
         }
 
         if (reader.imageCount() == -1) {
@@ -135,13 +147,13 @@ void Image::loadImage()
 
             this->animated = true;
 
-            util::DebugCount::increase("animated images");
+            animatedImageCount.increase();
         }
 
         this->currentPixmap = this->loadedPixmap;
 
         this->isLoaded = true;
-        util::DebugCount::increase("loaded images");
+        loadedImageCount.increase();
 
         if (!loadedEventQueued) {
             loadedEventQueued = true;
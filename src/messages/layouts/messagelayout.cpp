@@ -3,6 +3,8 @@
 #include "application.hpp"
 #include "singletons/emotemanager.hpp"
 #include "singletons/settingsmanager.hpp"
+#include "util/metrics.hpp"
+#include "util/tracing.hpp"
 
 #include <QApplication>
 #include <QDebug>
@@ -20,16 +22,25 @@ namespace chatterino {
 namespace messages {
 namespace layouts {
 
+namespace {
+
+util::metrics::Counter layoutCount("message layout");
+util::metrics::Counter bufferCount("message drawing buffers");
+util::metrics::Histogram layoutTime("message layout time");
+util::metrics::Histogram bufferTime("message buffer update time");
+
+}  // namespace
+
 MessageLayout::MessageLayout(MessagePtr _message)
     : message(_message)
     , buffer(nullptr)
 {
-    util::DebugCount::increase("message layout");
+    layoutCount.increase();
 }
 
 MessageLayout::~MessageLayout()
 {
-    util::DebugCount::decrease("message layout");
+    layoutCount.decrease();
 }
 
 Message *MessageLayout::getMessage()
@@ -109,6 +120,8 @@ bool MessageLayout::layout(int width, float scale, MessageElement::Flags flags)
 
 void MessageLayout::actuallyLayout(int width, MessageElement::Flags flags)
 {
+    util::metrics::Histogram::ScopedTimer timer(layoutTime);
+
     this->container.begin(width, this->scale, this->message->flags.value);
 
     for (const std::unique_ptr<MessageElement> &element : this->message->getElements()) {
@@ -125,7 +138,7 @@ void MessageLayout::actuallyLayout(int width, MessageElement::Flags flags)
 
 // Painting
 void MessageLayout::paint(QPainter &painter, int y, int messageIndex, Selection &selection,
-                          bool isLastReadMessage, bool isWindowFocused)
+                          bool isLastReadMessage, bool isWindowFocused, bool highTrafficMode)
 {
     auto app = getApp();
     QPixmap *pixmap = this->buffer.get();
@@ -143,11 +156,11 @@ void MessageLayout::paint(QPainter &painter, int y, int messageIndex, Selection
 
         this->buffer = std::shared_ptr<QPixmap>(pixmap);
         this->bufferValid = false;
-        util::DebugCount::increase("message drawing buffers");
+        bufferCount.increase();
     }
 
     if (!this->bufferValid || !selection.isEmpty()) {
-        this->updateBuffer(pixmap, messageIndex, selection);
+        this->updateBuffer(pixmap, messageIndex, selection, highTrafficMode);
     }
 
     // draw on buffer
@@ -168,7 +181,7 @@ void MessageLayout::paint(QPainter &painter, int y, int messageIndex, Selection
     }
 
     // draw message seperation line
-    if (app->settings->seperateMessages.getValue()) {
+    if (app->settings->seperateMessages.getValue() && !highTrafficMode) {
         painter.fillRect(0, y + this->container.getHeight() - 1, this->container.getWidth(), 1,
                          app->themes->splits.messageSeperator);
     }
@@ -187,8 +200,12 @@ void MessageLayout::paint(QPainter &painter, int y, int messageIndex, Selection
     this->bufferValid = true;
 }
 
-void MessageLayout::updateBuffer(QPixmap *buffer, int messageIndex, Selection &selection)
+void MessageLayout::updateBuffer(QPixmap *buffer, int messageIndex, Selection &selection,
+                                 bool highTrafficMode)
 {
+    util::metrics::Histogram::ScopedTimer timer(bufferTime);
+    util::tracing::Scope trace(util::tracing::Stage::BufferPaint);
+
     auto app = getApp();
 
     QPainter painter(buffer);
@@ -199,7 +216,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int messageIndex, Selection &s
     QColor backgroundColor;
     if (this->message->flags & Message::Highlighted) {
         backgroundColor = app->themes->messages.backgrounds.highlighted;
-    } else if (app->settings->alternateMessageBackground.getValue() &&
+    } else if (app->settings->alternateMessageBackground.getValue() && !highTrafficMode &&
                this->flags & MessageLayout::AlternateBackground) {
         backgroundColor = app->themes->messages.backgrounds.alternate;
     } else {
@@ -232,7 +249,7 @@ void MessageLayout::invalidateBuffer()
 void MessageLayout::deleteBuffer()
 {
     if (this->buffer != nullptr) {
-        util::DebugCount::decrease("message drawing buffers");
+        bufferCount.decrease();
 
         this->buffer = nullptr;
     }
@@ -40,8 +40,9 @@ public:
     bool layout(int width, float scale, MessageElement::Flags flags);
 
     // Painting
+    // highTrafficMode skips the alternating background and the separator line
     void paint(QPainter &painter, int y, int messageIndex, Selection &selection,
-               bool isLastReadMessage, bool isWindowFocused);
+               bool isLastReadMessage, bool isWindowFocused, bool highTrafficMode);
     void invalidateBuffer();
     void deleteBuffer();
     void deleteCache();
@@ -77,7 +78,8 @@ private:
 
     // methods
     void actuallyLayout(int width, MessageElement::Flags flags);
-    void updateBuffer(QPixmap *pixmap, int messageIndex, Selection &selection);
+    void updateBuffer(QPixmap *pixmap, int messageIndex, Selection &selection,
+                      bool highTrafficMode);
 };
 
 using MessageLayoutPtr = std::shared_ptr<MessageLayout>;
@@ -2,7 +2,7 @@
 
 #include "application.hpp"
 #include "messages/messageelement.hpp"
-#include "util/debugcount.hpp"
+#include "util/metrics.hpp"
 
 #include <QDebug>
 #include <QPainter>
@@ -11,6 +11,12 @@ namespace chatterino {
 namespace messages {
 namespace layouts {
 
+namespace {
+
+util::metrics::Counter layoutElementCount("message layout elements");
+
+}  // namespace
+
 const QRect &MessageLayoutElement::getRect() const
 {
     return this->rect;
@@ -20,12 +26,12 @@ MessageLayoutElement::MessageLayoutElement(MessageElement &_creator, const QSize
     : creator(_creator)
 {
     this->rect.setSize(size);
-    util::DebugCount::increase("message layout elements");
+    layoutElementCount.increase();
 }
 
 MessageLayoutElement::~MessageLayoutElement()
 {
-    util::DebugCount::decrease("message layout elements");
+    layoutElementCount.decrease();
 }
 
 MessageElement &MessageLayoutElement::getCreator() const
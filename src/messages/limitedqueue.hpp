@@ -4,6 +4,7 @@
 
 #include <QDebug>
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -132,6 +133,53 @@ public:
         return acceptedItems;
     }
 
+    // inserts the items before the item at index, returns the items that were removed from the
+    // start because the limit was reached
+    std::vector<T> insert(size_t index, const std::vector<T> &items)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        std::vector<T> allItems;
+        for (size_t i = 0; i < this->chunks->size(); i++) {
+            Chunk &chunk = this->chunks->at(i);
+
+            size_t start = i == 0 ? this->firstChunkOffset : 0;
+            size_t end = i == this->chunks->size() - 1 ? this->lastChunkEnd : chunk->size();
+
+            allItems.insert(allItems.end(), chunk->begin() + start, chunk->begin() + end);
+        }
+
+        index = std::min(index, allItems.size());
+        allItems.insert(allItems.begin() + index, items.begin(), items.end());
+
+        std::vector<T> deleted;
+        if (allItems.size() > this->limit) {
+            size_t count = allItems.size() - this->limit;
+
+            deleted.assign(allItems.begin(), allItems.begin() + count);
+            allItems.erase(allItems.begin(), allItems.begin() + count);
+        }
+
+        // rebuild the chunks, snapshots keep the old ones
+        ChunkVector newChunks = std::make_shared<std::vector<std::shared_ptr<std::vector<T>>>>();
+
+        for (size_t i = 0; i < allItems.size() || newChunks->empty(); i += this->chunkSize) {
+            Chunk chunk = std::make_shared<std::vector<T>>();
+            chunk->resize(this->chunkSize);
+
+            size_t end = std::min(i + this->chunkSize, allItems.size());
+            std::copy(allItems.begin() + i, allItems.begin() + end, chunk->begin());
+
+            newChunks->push_back(chunk);
+            this->lastChunkEnd = end - i;
+        }
+
+        this->chunks = newChunks;
+        this->firstChunkOffset = 0;
+
+        return deleted;
+    }
+
     // replace an single item, return index if successful, -1 if unsuccessful
     int replaceItem(const T &item, const T &replacement)
     {
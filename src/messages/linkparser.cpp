@@ -0,0 +1,248 @@
+#include "messages/linkparser.hpp"
+
+#include "messages/tldtable.hpp"
+
+#include <cstdint>
+
+namespace chatterino {
+namespace messages {
+
+namespace {
+
+inline uint16_t toLowerAscii(uint16_t c)
+{
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+inline uint16_t code(char c)
+{
+    return uint16_t(static_cast<unsigned char>(c));
+}
+
+inline uint16_t code(QChar c)
+{
+    return c.unicode();
+}
+
+// Has to match hash_tld in tools/tldtable/generate.py, which builds the table with it
+template <typename Char>
+uint32_t hashTld(uint32_t seed, const Char *begin, int length)
+{
+    // fnv-1a followed by the murmur3 finalizer
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+
+    for (int i = 0; i < length; i++) {
+        hash ^= toLowerAscii(code(begin[i]));
+        hash *= 16777619u;
+    }
+
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+inline bool isAsciiAlphaNumeric(uint16_t c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+inline bool isAsciiDigit(uint16_t c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool isEndOfHost(uint16_t c)
+{
+    return c == '/' || c == '?' || c == '#';
+}
+
+// punctuation around a link that isn't part of it, like in "(google.com)" or "google.com."
+inline bool isLeadingPunctuation(uint16_t c)
+{
+    return c == '(' || c == '[' || c == '{' || c == '<' || c == '"' || c == '\'' || c == '*';
+}
+
+inline bool isTrailingPunctuation(uint16_t c)
+{
+    return c == '.' || c == ',' || c == ';' || c == ':' || c == '!' || c == '?' || c == ')' ||
+           c == ']' || c == '}' || c == '>' || c == '"' || c == '\'' || c == '*';
+}
+
+// A closing bracket belongs to the link if the link opened it, like in
+// "en.wikipedia.org/wiki/Link_(The_Legend_of_Zelda)"
+inline bool isOpenedIn(const QChar *begin, const QChar *end, uint16_t closing)
+{
+    uint16_t opening = closing == ')' ? '(' : closing == ']' ? '[' : closing == '}' ? '{' : 0;
+
+    if (opening == 0) {
+        return false;
+    }
+
+    int depth = 0;
+    for (const QChar *it = begin; it != end; ++it) {
+        if (it->unicode() == opening) {
+            depth++;
+        } else if (it->unicode() == closing) {
+            depth--;
+        }
+    }
+
+    return depth > 0;
+}
+
+// Case insensitive check whether [it, end) starts with the lowercase string
+inline bool startsWith(const QChar *it, const QChar *end, const char *lowercase)
+{
+    for (; *lowercase != '\0'; ++it, ++lowercase) {
+        if (it == end || toLowerAscii(it->unicode()) != code(*lowercase)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace
+
+LinkParser::LinkParser(const QString &unparsedString)
+    : string(unparsedString)
+{
+    this->parse();
+}
+
+bool LinkParser::hasMatch() const
+{
+    return this->match;
+}
+
+bool LinkParser::hasScheme() const
+{
+    return this->scheme;
+}
+
+QString LinkParser::getCaptured() const
+{
+    if (!this->match) {
+        return QString();
+    }
+
+    return this->string.mid(this->capturedBegin, this->capturedLength);
+}
+
+bool LinkParser::isValidTld(const QChar *begin, int length)
+{
+    using namespace tldtable;
+
+    if (length < 2 || length > maxTldLength) {
+        return false;
+    }
+
+    uint32_t seed = displacements[hashTld(0, begin, length) & (bucketCount - 1)];
+    if (seed == 0) {
+        return false;
+    }
+
+    int index = slots[hashTld(seed, begin, length) & (slotCount - 1)];
+    if (index == -1) {
+        return false;
+    }
+
+    const char *tld = tlds[index];
+
+    for (int i = 0; i < length; i++) {
+        if (tld[i] == '\0' || code(tld[i]) != toLowerAscii(begin[i].unicode())) {
+            return false;
+        }
+    }
+
+    return tld[length] == '\0';
+}
+
+void LinkParser::parse()
+{
+    const QChar *begin = this->string.constData();
+    const QChar *end = begin + this->string.length();
+
+    while (begin != end && isLeadingPunctuation(begin->unicode())) {
+        ++begin;
+    }
+
+    while (end != begin && isTrailingPunctuation((end - 1)->unicode()) &&
+           !isOpenedIn(begin, end - 1, (end - 1)->unicode())) {
+        --end;
+    }
+
+    const QChar *it = begin;
+
+    // the shortest link is "a.co" and every link starts with a letter or digit
+    if (end - begin < 4 || !isAsciiAlphaNumeric(it->unicode())) {
+        return;
+    }
+
+    // scheme
+    if (startsWith(it, end, "https://")) {
+        it += 8;
+        this->scheme = true;
+    } else if (startsWith(it, end, "http://")) {
+        it += 7;
+        this->scheme = true;
+    }
+
+    // host, made up of at least two dot separated labels
+    const QChar *labelBegin = it;
+    bool hasDot = false;
+
+    for (; it != end; ++it) {
+        uint16_t c = it->unicode();
+
+        if (isAsciiAlphaNumeric(c) || c == '-') {
+            continue;
+        }
+
+        if (c == '.') {
+            if (it == labelBegin) {
+                return;
+            }
+
+            labelBegin = it + 1;
+            hasDot = true;
+            continue;
+        }
+
+        if (c == ':' || isEndOfHost(c)) {
+            break;
+        }
+
+        return;
+    }
+
+    if (!hasDot || !isValidTld(labelBegin, int(it - labelBegin))) {
+        return;
+    }
+
+    // port
+    if (it != end && it->unicode() == ':') {
+        ++it;
+
+        const QChar *portBegin = it;
+        while (it != end && isAsciiDigit(it->unicode())) {
+            ++it;
+        }
+
+        if (it == portBegin || (it != end && !isEndOfHost(it->unicode()))) {
+            return;
+        }
+    }
+
+    // everything after the host is part of the path
+    this->match = true;
+    this->capturedBegin = int(begin - this->string.constData());
+    this->capturedLength = int(end - begin);
+}
+
+}  // namespace messages
+}  // namespace chatterino
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QString>
+
+namespace chatterino {
+namespace messages {
+
+// Recognizes links like "google.com", "https://www.twitch.tv/pajlada" or "imgur.com:443/a/b" in a
+// single word of a message. Punctuation around the link, like in "(google.com)." is not part of
+// it. Recognizing a word does not allocate, only getCaptured does.
+class LinkParser
+{
+public:
+    explicit LinkParser(const QString &unparsedString);
+
+    bool hasMatch() const;
+
+    // Whether the link started with http:// or https://
+    bool hasScheme() const;
+
+    QString getCaptured() const;
+
+    static bool isValidTld(const QChar *begin, int length);
+
+private:
+    QString string;
+    bool match = false;
+    bool scheme = false;
+    int capturedBegin = 0;
+    int capturedLength = 0;
+
+    void parse();
+};
+
+}  // namespace messages
+}  // namespace chatterino
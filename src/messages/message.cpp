@@ -2,11 +2,29 @@
 #include "messageelement.hpp"
 #include "providers/twitch/pubsubactions.hpp"
 #include "util/irchelpers.hpp"
+#include "util/metrics.hpp"
 
 using SBHighlight = chatterino::widgets::ScrollbarHighlight;
 
 namespace chatterino {
 namespace messages {
+
+namespace {
+
+util::metrics::Counter messageCount("messages");
+
+}  // namespace
+
+Message::Message()
+{
+    messageCount.increase();
+}
+
+Message::~Message()
+{
+    messageCount.decrease();
+}
+
 void Message::addElement(MessageElement *element)
 {
     this->elements.push_back(std::unique_ptr<MessageElement>(element));
@@ -30,7 +48,8 @@ MessagePtr Message::createSystemMessage(const QString &text)
 {
     MessagePtr message(new Message);
 
-    message->addElement(new TimestampElement(QTime::currentTime()));
+    message->serverReceivedTime = QDateTime::currentDateTime();
+    message->addElement(new TimestampElement(message->serverReceivedTime.time()));
     message->addElement(new TextElement(text, MessageElement::Text, MessageColor::System));
     message->flags.EnableFlag(MessageFlags::System);
     message->searchText = text;
@@ -83,7 +102,8 @@ MessagePtr Message::createTimeoutMessage(const providers::twitch::BanAction &act
 {
     MessagePtr msg(new Message);
 
-    msg->addElement(new TimestampElement(QTime::currentTime()));
+    msg->serverReceivedTime = QDateTime::currentDateTime();
+    msg->addElement(new TimestampElement(msg->serverReceivedTime.time()));
     msg->flags.EnableFlag(MessageFlags::System);
     msg->flags.EnableFlag(MessageFlags::Timeout);
 
@@ -134,7 +154,8 @@ MessagePtr Message::createUntimeoutMessage(const providers::twitch::UnbanAction
 {
     MessagePtr msg(new Message);
 
-    msg->addElement(new TimestampElement(QTime::currentTime()));
+    msg->serverReceivedTime = QDateTime::currentDateTime();
+    msg->addElement(new TimestampElement(msg->serverReceivedTime.time()));
     msg->flags.EnableFlag(MessageFlags::System);
     msg->flags.EnableFlag(MessageFlags::Untimeout);
 
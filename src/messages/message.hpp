@@ -5,27 +5,19 @@
 #include "util/flagsenum.hpp"
 #include "widgets/helper/scrollbarhighlight.hpp"
 
+#include <QDateTime>
 #include <QTime>
 
 #include <cinttypes>
 #include <memory>
 #include <vector>
 
-#include "util/debugcount.hpp"
-
 namespace chatterino {
 namespace messages {
 
 struct Message {
-    Message()
-    {
-        util::DebugCount::increase("messages");
-    }
-
-    ~Message()
-    {
-        util::DebugCount::decrease("messages");
-    }
+    Message();
+    ~Message();
 
     enum MessageFlags : uint16_t {
         None = 0,
@@ -43,12 +35,16 @@ struct Message {
 
     util::FlagsEnum<MessageFlags> flags;
     QTime parseTime;
+    // when the server received the message, messages of a channel are ordered by it
+    QDateTime serverReceivedTime;
     QString id;
     QString searchText;
     QString loginName;
     QString displayName;
     QString localizedName;
     QString timeoutUser;
+    // raw irc tags, only set while structured logs are written
+    QString ircTags;
 
     std::unique_ptr<providers::twitch::BanAction> banAction;
     uint32_t count = 1;
@@ -1,4 +1,5 @@
 #include "messagebuilder.hpp"
+#include "messages/linkparser.hpp"
 #include "singletons/emotemanager.hpp"
 #include "singletons/resourcemanager.hpp"
 #include "singletons/thememanager.hpp"
@@ -15,6 +16,11 @@ MessageBuilder::MessageBuilder()
 
 MessagePtr MessageBuilder::getMessage()
 {
+    // builders set the time the server sent the message at if they know it
+    if (!this->message->serverReceivedTime.isValid()) {
+        this->message->serverReceivedTime = QDateTime::currentDateTime();
+    }
+
     return this->message;
 }
 
@@ -44,18 +50,15 @@ void MessageBuilder::appendTimestamp(const QTime &time)
 
 QString MessageBuilder::matchLink(const QString &string)
 {
-    static QRegularExpression linkRegex("[[:ascii:]]*\\.[a-zA-Z]+\\/?[[:ascii:]]*");
-    static QRegularExpression httpRegex("\\bhttps?://");
-
-    auto match = linkRegex.match(string);
+    LinkParser linkParser(string);
 
-    if (!match.hasMatch()) {
+    if (!linkParser.hasMatch()) {
         return QString();
     }
 
-    QString captured = match.captured();
+    QString captured = linkParser.getCaptured();
 
-    if (!captured.contains(httpRegex)) {
+    if (!linkParser.hasScheme()) {
         captured.insert(0, "http://");
     }
 
@@ -6,19 +6,26 @@
 #include "singletons/settingsmanager.hpp"
 #include "util/benchmark.hpp"
 #include "util/emotemap.hpp"
+#include "util/metrics.hpp"
 
 namespace chatterino {
 namespace messages {
 
+namespace {
+
+util::metrics::Counter messageElementCount("message elements");
+
+}  // namespace
+
 MessageElement::MessageElement(Flags _flags)
     : flags(_flags)
 {
-    util::DebugCount::increase("message elements");
+    messageElementCount.increase();
 }
 
 MessageElement::~MessageElement()
 {
-    util::DebugCount::decrease("message elements");
+    messageElementCount.decrease();
 }
 
 MessageElement *MessageElement::setLink(const Link &_link)
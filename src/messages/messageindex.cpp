@@ -0,0 +1,230 @@
+#include "messages/messageindex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace chatterino {
+namespace messages {
+
+namespace {
+
+std::vector<uint64_t> intersect(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b)
+{
+    std::vector<uint64_t> result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+}  // namespace
+
+void MessageIndex::add(const MessagePtr &message)
+{
+    if (!message || this->sequences.count(message.get()) != 0) {
+        return;
+    }
+
+    uint64_t sequence = this->nextSequence++;
+
+    this->messages.emplace(sequence, message);
+    this->sequences.emplace(message.get(), sequence);
+
+    // sequences only grow, so the postings stay sorted
+    Keys keys = getKeys(*message);
+
+    for (const QString &word : keys.words) {
+        this->words[word].push_back(sequence);
+    }
+
+    if (!keys.user.isEmpty()) {
+        this->users[keys.user].push_back(sequence);
+    }
+
+    if (keys.hasLink) {
+        this->links.push_back(sequence);
+    }
+
+    if (keys.isHighlighted) {
+        this->highlighted.push_back(sequence);
+    }
+}
+
+void MessageIndex::remove(const MessagePtr &message)
+{
+    if (!message) {
+        return;
+    }
+
+    auto it = this->sequences.find(message.get());
+    if (it == this->sequences.end()) {
+        return;
+    }
+
+    uint64_t sequence = it->second;
+    Keys keys = getKeys(*message);
+
+    for (const QString &word : keys.words) {
+        erase(this->words, word, sequence);
+    }
+
+    if (!keys.user.isEmpty()) {
+        erase(this->users, keys.user, sequence);
+    }
+
+    // the flags could have changed since the message was added, erasing is a no-op then
+    erase(this->links, sequence);
+    erase(this->highlighted, sequence);
+
+    this->sequences.erase(it);
+    this->messages.erase(sequence);
+}
+
+void MessageIndex::clear()
+{
+    this->messages.clear();
+    this->sequences.clear();
+    this->words.clear();
+    this->users.clear();
+    this->links.clear();
+    this->highlighted.clear();
+}
+
+size_t MessageIndex::size() const
+{
+    return this->messages.size();
+}
+
+std::vector<MessagePtr> MessageIndex::search(const SearchQuery &query) const
+{
+    std::vector<MessagePtr> results;
+
+    for (const MessagePtr &message : this->findCandidates(query)) {
+        if (query.matches(*message)) {
+            results.push_back(message);
+        }
+    }
+
+    // messages that were added at the start or filled in later aren't in the order they were sent
+    std::stable_sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+        return a->serverReceivedTime < b->serverReceivedTime;
+    });
+
+    return results;
+}
+
+std::vector<MessagePtr> MessageIndex::findCandidates(const SearchQuery &query) const
+{
+    // the candidates are the messages that are in all of the postings the query uses, they still
+    // have to be checked against the query for the dates and the exact user names
+    std::vector<std::vector<uint64_t>> lists;
+
+    for (const QString &word : query.words) {
+        lists.push_back(this->findPrefix(word));
+    }
+
+    if (!query.users.isEmpty()) {
+        std::vector<uint64_t> list;
+
+        for (const QString &user : query.users) {
+            auto it = this->users.find(user);
+
+            if (it != this->users.end()) {
+                list.insert(list.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        std::sort(list.begin(), list.end());
+        lists.push_back(std::move(list));
+    }
+
+    if (query.hasLink) {
+        lists.emplace_back(this->links.begin(), this->links.end());
+    }
+
+    if (query.isHighlighted) {
+        lists.emplace_back(this->highlighted.begin(), this->highlighted.end());
+    }
+
+    std::vector<MessagePtr> candidates;
+
+    if (lists.empty()) {
+        for (const auto &item : this->messages) {
+            candidates.push_back(item.second);
+        }
+    } else {
+        // intersect the smallest lists first to keep the intermediate results small
+        std::sort(lists.begin(), lists.end(),
+                  [](const auto &a, const auto &b) { return a.size() < b.size(); });
+
+        std::vector<uint64_t> sequences = std::move(lists.front());
+
+        for (size_t i = 1; i < lists.size() && !sequences.empty(); i++) {
+            sequences = intersect(sequences, lists[i]);
+        }
+
+        for (uint64_t sequence : sequences) {
+            candidates.push_back(this->messages.at(sequence));
+        }
+    }
+
+    return candidates;
+}
+
+MessageIndex::Keys MessageIndex::getKeys(const Message &message)
+{
+    Keys keys;
+
+    // a word that is in the message more than once is only added once
+    for (const QString &word : SearchQuery::tokenize(message.searchText)) {
+        keys.words.insert(word);
+    }
+
+    keys.user = message.loginName.toLower();
+    keys.hasLink = SearchQuery::containsLink(message);
+    keys.isHighlighted = message.flags.HasFlag(Message::Highlighted);
+
+    return keys;
+}
+
+void MessageIndex::erase(Postings &postings, uint64_t sequence)
+{
+    // messages are usually removed from the start of the channel, that is the front here
+    auto it = std::lower_bound(postings.begin(), postings.end(), sequence);
+
+    if (it != postings.end() && *it == sequence) {
+        postings.erase(it);
+    }
+}
+
+void MessageIndex::erase(std::map<QString, Postings> &map, const QString &key, uint64_t sequence)
+{
+    auto it = map.find(key);
+    if (it == map.end()) {
+        return;
+    }
+
+    erase(it->second, sequence);
+
+    // don't keep the words that aren't in any message anymore
+    if (it->second.empty()) {
+        map.erase(it);
+    }
+}
+
+std::vector<uint64_t> MessageIndex::findPrefix(const QString &prefix) const
+{
+    std::vector<uint64_t> result;
+
+    for (auto it = this->words.lower_bound(prefix);
+         it != this->words.end() && it->first.startsWith(prefix); ++it) {
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+
+    // a message is in the postings of every word it has with that prefix
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+}  // namespace messages
+}  // namespace chatterino
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "messages/message.hpp"
+#include "messages/searchquery.hpp"
+
+#include <QSet>
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+namespace messages {
+
+// Inverted index over the messages of a channel. It is updated when messages are added or
+// removed, so a search only looks at the messages that can match instead of all of them.
+class MessageIndex
+{
+public:
+    void add(const MessagePtr &message);
+    void remove(const MessagePtr &message);
+    void clear();
+
+    size_t size() const;
+
+    // The messages that match the query, oldest first
+    std::vector<MessagePtr> search(const SearchQuery &query) const;
+
+    // The messages that can match the query in the order they were added. They still have to be
+    // checked with SearchQuery::matches, which can be done on another thread.
+    std::vector<MessagePtr> findCandidates(const SearchQuery &query) const;
+
+private:
+    // sequence numbers of the messages in the order they were added
+    using Postings = std::deque<uint64_t>;
+
+    // what a message is found by
+    struct Keys {
+        QSet<QString> words;
+        QString user;
+        bool hasLink = false;
+        bool isHighlighted = false;
+    };
+
+    static Keys getKeys(const Message &message);
+    static void erase(Postings &postings, uint64_t sequence);
+    static void erase(std::map<QString, Postings> &map, const QString &key, uint64_t sequence);
+
+    // every message that has a word starting with the prefix
+    std::vector<uint64_t> findPrefix(const QString &prefix) const;
+
+    uint64_t nextSequence = 0;
+    std::map<uint64_t, MessagePtr> messages;
+    std::unordered_map<const Message *, uint64_t> sequences;
+
+    // words are searched by prefix so they are kept sorted
+    std::map<QString, Postings> words;
+    std::map<QString, Postings> users;
+    Postings links;
+    Postings highlighted;
+};
+
+}  // namespace messages
+}  // namespace chatterino
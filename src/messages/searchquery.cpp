@@ -0,0 +1,199 @@
+#include "messages/searchquery.hpp"
+
+#include "messages/message.hpp"
+
+namespace chatterino {
+namespace messages {
+
+namespace {
+
+// a date without a time is the start of the day
+QDateTime parseDate(const QString &text)
+{
+    QDateTime dateTime = QDateTime::fromString(text, Qt::ISODate);
+
+    if (!dateTime.isValid()) {
+        QDate date = QDate::fromString(text, "yyyy-MM-dd");
+
+        if (date.isValid()) {
+            dateTime = QDateTime(date);
+        }
+    }
+
+    return dateTime;
+}
+
+}  // namespace
+
+SearchQuery SearchQuery::parse(const QString &text)
+{
+    SearchQuery query;
+
+    for (const QString &part : text.split(' ', QString::SkipEmptyParts)) {
+        int colon = part.indexOf(':');
+
+        if (colon > 0 && colon < part.length() - 1) {
+            QString key = part.left(colon).toLower();
+            QString value = part.mid(colon + 1);
+
+            if (key == "from") {
+                query.users.append(value.toLower());
+                continue;
+            }
+
+            if (key == "has" && value.compare("link", Qt::CaseInsensitive) == 0) {
+                query.hasLink = true;
+                continue;
+            }
+
+            if (key == "is" && value.compare("highlighted", Qt::CaseInsensitive) == 0) {
+                query.isHighlighted = true;
+                continue;
+            }
+
+            if (key == "after" || key == "before") {
+                QDateTime dateTime = parseDate(value);
+
+                if (dateTime.isValid()) {
+                    (key == "after" ? query.after : query.before) = dateTime;
+                    continue;
+                }
+            }
+        }
+
+        query.words.append(tokenize(part));
+    }
+
+    return query;
+}
+
+QStringList SearchQuery::tokenize(const QString &text)
+{
+    QStringList tokens;
+    int start = -1;
+
+    for (int i = 0; i <= text.length(); i++) {
+        bool isWordCharacter = i < text.length() && text[i].isLetterOrNumber();
+
+        if (isWordCharacter && start == -1) {
+            start = i;
+        } else if (!isWordCharacter && start != -1) {
+            tokens.append(text.mid(start, i - start).toLower());
+            start = -1;
+        }
+    }
+
+    return tokens;
+}
+
+bool SearchQuery::containsLink(const Message &message)
+{
+    for (const auto &element : message.getElements()) {
+        if (element->getLink().type == Link::Url) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SearchQuery::isEmpty() const
+{
+    return this->words.isEmpty() && this->users.isEmpty() && !this->hasLink &&
+           !this->isHighlighted && !this->after.isValid() && !this->before.isValid();
+}
+
+bool SearchQuery::matches(const Message &message) const
+{
+    if (this->after.isValid() && message.serverReceivedTime < this->after) {
+        return false;
+    }
+
+    if (this->before.isValid() && message.serverReceivedTime >= this->before) {
+        return false;
+    }
+
+    if (this->isHighlighted && !message.flags.HasFlag(Message::Highlighted)) {
+        return false;
+    }
+
+    if (!this->users.isEmpty() && !this->users.contains(message.loginName.toLower())) {
+        return false;
+    }
+
+    if (this->hasLink && !containsLink(message)) {
+        return false;
+    }
+
+    if (this->words.isEmpty()) {
+        return true;
+    }
+
+    QStringList tokens = tokenize(message.searchText);
+
+    for (const QString &word : this->words) {
+        bool found = false;
+
+        for (const QString &token : tokens) {
+            if (token.startsWith(word)) {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SearchQuery::isRefinementOf(const SearchQuery &previous) const
+{
+    // users match any of them, so a refinement can only leave some out
+    if (!previous.users.isEmpty()) {
+        if (this->users.isEmpty()) {
+            return false;
+        }
+
+        for (const QString &user : this->users) {
+            if (!previous.users.contains(user)) {
+                return false;
+            }
+        }
+    }
+
+    if ((previous.hasLink && !this->hasLink) || (previous.isHighlighted && !this->isHighlighted)) {
+        return false;
+    }
+
+    if (previous.after.isValid() && (!this->after.isValid() || this->after < previous.after)) {
+        return false;
+    }
+
+    if (previous.before.isValid() && (!this->before.isValid() || this->before > previous.before)) {
+        return false;
+    }
+
+    // a word that starts with one of our words also starts with the shorter previous word
+    for (const QString &previousWord : previous.words) {
+        bool found = false;
+
+        for (const QString &word : this->words) {
+            if (word.startsWith(previousWord)) {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace messages
+}  // namespace chatterino
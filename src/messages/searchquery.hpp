@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+
+namespace chatterino {
+namespace messages {
+
+struct Message;
+
+// A search as it is typed into the search popup. Every word has to be the start of a word in the
+// message, filters are written as key:value
+//   from:<user>      messages of the user, multiple users match any of them
+//   has:link         messages that contain a link
+//   is:highlighted   highlighted messages
+//   after:<date>     messages sent at or after the date (yyyy-MM-dd or ISO 8601)
+//   before:<date>    messages sent before the date
+// Unknown filters are searched for as words.
+class SearchQuery
+{
+public:
+    static SearchQuery parse(const QString &text);
+
+    // The lowercase words of a text, the index and the query split the same way
+    static QStringList tokenize(const QString &text);
+    static bool containsLink(const Message &message);
+
+    bool isEmpty() const;
+    bool matches(const Message &message) const;
+
+    // If every message that matches this query also matches the previous one, e.g. when more was
+    // typed. The results of the previous query can be searched instead of all messages then.
+    bool isRefinementOf(const SearchQuery &previous) const;
+
+    QStringList words;
+    QStringList users;
+    bool hasLink = false;
+    bool isHighlighted = false;
+    QDateTime after;
+    QDateTime before;
+};
+
+}  // namespace messages
+}  // namespace chatterino
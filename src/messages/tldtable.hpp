@@ -0,0 +1,154 @@
+// Generated by tools/tldtable/generate.py, don't edit it by hand
+
+#pragma once
+
+#include <cstdint>
+
+namespace chatterino {
+namespace messages {
+namespace tldtable {
+
+const int bucketCount = 128;
+const int slotCount = 1024;
+const int maxTldLength = 10;
+
+// clang-format off
+const char *const tlds[] = {
+    "ac", "academy", "ad", "ae", "aero", "af", "ag", "agency",
+    "ai", "al", "am", "amazon", "ao", "app", "apple", "aq",
+    "ar", "arpa", "art", "as", "asia", "at", "au", "audio",
+    "aw", "ax", "az", "ba", "bar", "bb", "bd", "be",
+    "berlin", "bet", "bf", "bg", "bh", "bi", "biz", "bj",
+    "black", "blog", "blue", "bm", "bn", "bo", "bq", "br",
+    "bs", "bt", "business", "bw", "by", "bz", "ca", "care",
+    "casino", "cat", "cc", "cd", "center", "cf", "cg", "ch",
+    "chat", "ci", "city", "ck", "cl", "cloud", "club", "cm",
+    "cn", "co", "codes", "com", "community", "company", "cool", "coop",
+    "cr", "cu", "cv", "cw", "cx", "cy", "cz", "de",
+    "design", "dev", "digital", "dj", "dk", "dm", "do", "dog",
+    "download", "dz", "ec", "edu", "education", "ee", "eg", "email",
+    "er", "es", "et", "eu", "events", "fail", "fan", "fans",
+    "fi", "film", "finance", "fj", "fk", "fm", "fo", "fr",
+    "fun", "fyi", "ga", "gallery", "game", "games", "gay", "gb",
+    "gd", "ge", "gf", "gg", "gh", "gi", "gl", "gm",
+    "gmbh", "gn", "gold", "google", "gov", "gp", "gq", "gr",
+    "green", "group", "gs", "gt", "gu", "guide", "gw", "gy",
+    "health", "help", "hk", "hm", "hn", "host", "hosting", "hr",
+    "ht", "hu", "icu", "id", "ie", "il", "im", "in",
+    "inc", "info", "int", "io", "iq", "ir", "is", "it",
+    "je", "jm", "jo", "jobs", "jp", "ke", "kg", "kh",
+    "ki", "km", "kn", "kp", "kr", "kw", "ky", "kz",
+    "la", "land", "lb", "lc", "li", "life", "link", "live",
+    "lk", "llc", "lol", "london", "love", "lr", "ls", "lt",
+    "ltd", "lu", "lv", "ly", "ma", "market", "mc", "md",
+    "me", "media", "mg", "mh", "microsoft", "mil", "mk", "ml",
+    "mm", "mn", "mo", "mobi", "moe", "mom", "money", "movie",
+    "mp", "mq", "mr", "ms", "mt", "mu", "museum", "music",
+    "mv", "mw", "mx", "my", "mz", "na", "name", "nc",
+    "ne", "net", "network", "news", "nf", "ng", "ni", "ninja",
+    "nl", "no", "np", "nr", "nu", "nyc", "nz", "om",
+    "one", "online", "org", "pa", "page", "paris", "party", "pe",
+    "pf", "pg", "ph", "photo", "photos", "pics", "pictures", "pink",
+    "pk", "pl", "place", "plus", "pm", "pn", "poker", "porn",
+    "post", "pr", "pro", "ps", "pt", "pub", "pw", "py",
+    "qa", "radio", "re", "red", "review", "reviews", "ro", "rocks",
+    "rs", "ru", "run", "rw", "sa", "sb", "sc", "school",
+    "science", "sd", "se", "sexy", "sg", "sh", "shop", "show",
+    "si", "site", "sk", "sl", "sm", "sn", "so", "social",
+    "software", "solutions", "space", "sr", "ss", "st", "store", "stream",
+    "studio", "su", "support", "sv", "sx", "sy", "systems", "sz",
+    "tc", "td", "team", "tech", "tel", "tf", "tg", "th",
+    "tickets", "tips", "tj", "tk", "tl", "tm", "tn", "to",
+    "today", "tokyo", "tools", "top", "tr", "travel", "tt", "tube",
+    "tv", "tw", "tz", "ua", "ug", "uk", "university", "us",
+    "uy", "uz", "va", "vc", "ve", "vg", "vi", "video",
+    "vip", "vn", "vu", "watch", "website", "wf", "wiki", "work",
+    "world", "ws", "wtf", "xxx", "xyz", "ye", "youtube", "yt",
+    "za", "zm", "zone", "zw",
+};
+
+const uint32_t displacements[bucketCount] = {
+    3, 1, 1, 1, 1, 5, 2, 3, 2, 0, 1, 4,
+    1, 1, 1, 2, 3, 2, 2, 3, 1, 2, 1, 1,
+    1, 1, 1, 1, 2, 2, 1, 2, 0, 1, 1, 2,
+    1, 4, 1, 3, 3, 1, 1, 1, 1, 2, 3, 1,
+    2, 1, 0, 1, 1, 1, 1, 2, 3, 1, 2, 5,
+    4, 1, 2, 2, 4, 1, 0, 2, 1, 1, 4, 1,
+    1, 8, 3, 3, 1, 1, 1, 1, 1, 3, 7, 1,
+    1, 1, 2, 1, 3, 2, 2, 2, 1, 2, 1, 1,
+    2, 1, 3, 1, 4, 1, 1, 4, 5, 2, 1, 4,
+    2, 3, 2, 4, 1, 1, 2, 1, 2, 3, 2, 5,
+    1, 1, 1, 5, 3, 13, 3, 1,
+};
+
+const int16_t slots[slotCount] = {
+    -1, 3, 12, -1, 339, -1, -1, -1, -1, 318, -1, -1, -1, -1, 313, 11,
+    207, -1, -1, -1, -1, -1, 354, -1, -1, 65, 275, 79, 195, 342, -1, -1,
+    361, -1, -1, 90, -1, -1, -1, -1, -1, -1, -1, 380, -1, -1, -1, -1,
+    67, -1, -1, 235, -1, 323, -1, 295, 58, 18, -1, -1, 315, -1, 36, 59,
+    -1, 366, -1, 152, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 102, -1, -1, -1, -1, -1, 91, 212, -1, -1, -1, -1, -1, 123, 168,
+    -1, 78, -1, 0, 377, -1, -1, 100, -1, -1, 206, 290, 21, -1, -1, 387,
+    35, -1, -1, 268, -1, 9, -1, 73, 266, 211, 143, -1, -1, -1, -1, -1,
+    -1, -1, 54, -1, 136, -1, -1, 384, -1, -1, -1, -1, -1, 174, -1, -1,
+    -1, -1, -1, 385, 311, -1, -1, 148, 31, -1, -1, 103, 181, -1, -1, -1,
+    29, -1, -1, 74, -1, -1, 353, -1, -1, -1, 299, 341, -1, -1, -1, 276,
+    158, 164, 254, 10, 312, -1, -1, 213, 72, 125, -1, -1, -1, 150, -1, -1,
+    -1, -1, 297, -1, -1, -1, 307, -1, 179, -1, -1, -1, 56, 375, 82, -1,
+    -1, 220, -1, 118, -1, 187, -1, -1, -1, -1, -1, -1, -1, 110, 114, 340,
+    -1, -1, -1, 77, 42, -1, -1, -1, 273, -1, -1, -1, 329, -1, -1, 216,
+    161, 61, 352, 223, -1, 1, -1, -1, -1, 204, -1, -1, 350, -1, 201, -1,
+    392, 50, 134, -1, -1, -1, -1, -1, -1, 83, -1, -1, 386, 294, -1, 258,
+    237, 28, -1, 327, -1, 108, -1, -1, -1, 170, -1, 210, -1, -1, -1, -1,
+    -1, -1, -1, -1, 111, -1, 331, -1, 269, -1, -1, 51, -1, -1, -1, -1,
+    -1, 343, -1, -1, 157, -1, 225, -1, -1, 33, -1, -1, -1, 337, -1, -1,
+    4, 280, -1, -1, -1, 317, -1, -1, -1, -1, -1, 189, -1, 197, 140, -1,
+    244, -1, -1, 43, 156, 115, -1, 296, -1, -1, -1, -1, 44, 255, 326, 32,
+    -1, -1, -1, 185, -1, -1, -1, -1, -1, -1, 248, 127, 279, -1, 121, 230,
+    -1, 26, -1, -1, -1, -1, -1, 335, -1, 92, 172, 20, -1, -1, 263, -1,
+    -1, -1, -1, 249, -1, -1, 393, 167, 16, -1, 75, -1, 264, -1, -1, 238,
+    401, -1, -1, 55, -1, -1, -1, -1, -1, -1, -1, 25, -1, 399, -1, -1,
+    -1, 173, 178, -1, 131, -1, -1, 147, 288, -1, 71, -1, -1, 126, -1, 348,
+    184, -1, -1, 105, -1, 267, -1, -1, -1, 188, 292, -1, 146, 274, -1, -1,
+    175, 217, 176, -1, 165, -1, 52, 259, 47, -1, -1, -1, -1, -1, -1, -1,
+    272, -1, -1, 39, -1, 300, 76, 305, 209, 142, -1, -1, -1, -1, 379, -1,
+    231, -1, -1, -1, 166, -1, -1, 236, 98, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 383, -1, -1, -1, 34, -1, -1, -1, -1, -1, -1, -1, 402, 182,
+    265, -1, 15, 208, -1, -1, -1, 112, 87, -1, -1, 60, -1, -1, -1, -1,
+    246, -1, -1, 191, 391, 229, -1, -1, 30, 277, 13, -1, -1, -1, -1, 242,
+    -1, 358, -1, 285, -1, 374, -1, -1, -1, -1, 96, -1, 6, -1, 382, -1,
+    -1, -1, 88, 356, -1, 68, 24, -1, -1, 314, -1, -1, 162, -1, -1, -1,
+    -1, -1, 390, -1, 239, 37, 243, 370, -1, 397, 63, -1, -1, -1, -1, -1,
+    -1, -1, 322, 394, -1, -1, -1, -1, -1, -1, 262, 183, 232, -1, -1, -1,
+    -1, -1, -1, -1, -1, 17, 196, 368, 97, -1, 253, 325, -1, 359, 190, -1,
+    -1, 378, -1, 57, 219, 117, 155, 84, -1, 388, -1, 328, 270, -1, -1, 332,
+    124, 151, 302, 228, 247, -1, -1, -1, 324, 245, 86, 346, -1, -1, 69, 101,
+    -1, 133, -1, -1, 171, 330, 234, 308, 205, 122, 367, -1, -1, -1, -1, -1,
+    369, -1, 345, 159, -1, 336, 271, 227, 250, -1, 286, 199, 154, 349, -1, -1,
+    149, 5, -1, -1, -1, 240, -1, 222, -1, -1, -1, -1, -1, 128, -1, -1,
+    -1, -1, -1, -1, 80, -1, -1, 93, 85, 200, 41, 373, -1, 38, -1, -1,
+    -1, -1, -1, 214, 138, 19, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, 89, -1, -1, 113, -1, 320, 321, -1, -1, -1, -1, -1, -1, 365,
+    -1, -1, -1, 257, -1, -1, -1, 104, -1, 364, 298, -1, 218, -1, -1, -1,
+    363, 396, -1, 256, -1, -1, -1, -1, -1, 116, -1, 395, -1, -1, 99, 398,
+    400, -1, 198, -1, -1, 202, -1, -1, 180, -1, -1, -1, -1, -1, 282, -1,
+    -1, 130, -1, 95, 135, -1, -1, 371, 132, -1, 109, 153, -1, 376, -1, 381,
+    319, 139, -1, 334, 186, 129, 106, -1, -1, -1, -1, -1, 137, -1, 163, 49,
+    -1, 107, -1, -1, 203, -1, -1, 194, 192, -1, -1, 94, 8, -1, 301, -1,
+    -1, 22, -1, -1, -1, 303, -1, -1, 291, -1, -1, 293, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, 304, -1, -1, -1, -1, 309, 45,
+    2, -1, -1, -1, -1, 120, -1, 283, -1, 310, -1, -1, 160, 287, 403, 64,
+    -1, 289, -1, 23, 7, 357, -1, 251, -1, -1, -1, -1, -1, -1, 355, 306,
+    119, -1, -1, 14, -1, 81, -1, -1, -1, -1, -1, 53, -1, -1, -1, 389,
+    252, -1, -1, -1, 48, -1, 233, -1, 347, 338, -1, -1, -1, -1, 333, 193,
+    -1, -1, -1, 66, -1, -1, -1, 40, -1, -1, 372, -1, -1, 62, -1, -1,
+    -1, -1, -1, -1, 141, -1, 46, -1, -1, 70, -1, -1, -1, -1, 344, 281,
+    -1, -1, -1, -1, -1, -1, 260, 215, -1, 362, -1, 221, -1, -1, -1, 261,
+    -1, 241, 27, 278, -1, -1, -1, -1, -1, 316, -1, -1, 360, 145, 284, -1,
+    -1, 226, 169, -1, -1, -1, -1, 351, -1, -1, 177, -1, -1, -1, 144, 224,
+};
+// clang-format on
+
+}  // namespace tldtable
+}  // namespace messages
+}  // namespace chatterino
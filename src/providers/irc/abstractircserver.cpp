@@ -3,6 +3,14 @@
 #include "common.hpp"
 #include "messages/limitedqueuesnapshot.hpp"
 #include "messages/message.hpp"
+#include "util/metrics.hpp"
+#include "util/posttothread.hpp"
+#include "util/tracing.hpp"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <random>
 
 using namespace chatterino::messages;
 
@@ -10,7 +18,30 @@ namespace chatterino {
 namespace providers {
 namespace irc {
 
+namespace {
+
+// delay before a read connection that dropped connects again, doubled with every failed attempt
+const int minReconnectDelay = 1000;
+const int maxReconnectDelay = 60000;
+
+// twitch allows 20 joins per 10 seconds, joins that don't fit are retried on the join timer
+const int joinsPerPeriod = 20;
+const int joinPeriod = 10000;
+const int joinInterval = 250;
+
+// twitch allows 20 messages per 30 seconds, or 100 in channels the user moderates
+const int regularMessagesPerPeriod = 20;
+const int elevatedMessagesPerPeriod = 100;
+const int messagePeriod = 30000;
+const int sendInterval = 100;
+
+util::metrics::Gauge sendQueueDepth("irc send queue depth");
+
+}  // namespace
+
 AbstractIrcServer::AbstractIrcServer()
+    : joinScheduler(joinsPerPeriod, joinPeriod)
+    , sendQueue(regularMessagesPerPeriod, elevatedMessagesPerPeriod, messagePeriod)
 {
     // Initialize the connections
     this->writeConnection.reset(new Communi::IrcConnection);
@@ -19,75 +50,155 @@ AbstractIrcServer::AbstractIrcServer()
     QObject::connect(this->writeConnection.get(), &Communi::IrcConnection::messageReceived,
                      [this](auto msg) { this->writeConnectionMessageReceived(msg); });
 
-    // Listen to read connection message signals
-    this->readConnection.reset(new Communi::IrcConnection);
-    this->readConnection->moveToThread(QCoreApplication::instance()->thread());
+    // the primary read connection
+    this->addReadConnection();
+
+    this->joinTimer.setInterval(joinInterval);
+    QObject::connect(&this->joinTimer, &QTimer::timeout, [this] { this->sendScheduledJoins(); });
 
-    QObject::connect(this->readConnection.get(), &Communi::IrcConnection::messageReceived,
-                     [this](auto msg) { this->messageReceived(msg); });
-    QObject::connect(this->readConnection.get(), &Communi::IrcConnection::privateMessageReceived,
-                     [this](auto msg) { this->privateMessageReceived(msg); });
-    QObject::connect(this->readConnection.get(), &Communi::IrcConnection::connected,
-                     [this] { this->onConnected(); });
-    QObject::connect(this->readConnection.get(), &Communi::IrcConnection::disconnected,
-                     [this] { this->onDisconnected(); });
+    this->sendTimer.setInterval(sendInterval);
+    QObject::connect(&this->sendTimer, &QTimer::timeout, [this] { this->sendQueuedMessages(); });
 }
 
-Communi::IrcConnection *AbstractIrcServer::getReadConnection() const
+AbstractIrcServer::~AbstractIrcServer()
 {
-    return this->readConnection.get();
+    for (auto &readConnection : this->readConnections) {
+        readConnection->thread.quit();
+        readConnection->thread.wait();
+
+        // runs the pending events of the thread, which skip themselves once the connection is gone
+        readConnection->connection.reset();
+    }
+
+    for (Communi::IrcMessage *message : this->pendingMessages) {
+        delete message;
+    }
 }
 
 void AbstractIrcServer::connect()
 {
     this->disconnect();
 
-    //    if (this->hasSeperateWriteConnection()) {
-    this->initializeConnection(this->writeConnection.get(), false, true);
-    this->initializeConnection(this->readConnection.get(), true, false);
-    //    } else {
-    //        this->initializeConnection(this->readConnection.get(), true, true);
-    //    }
+    this->shouldBeConnected = true;
 
-    // fourtf: this should be asynchronous
     {
-        std::lock_guard<std::mutex> lock1(this->connectionMutex);
-        std::lock_guard<std::mutex> lock2(this->channelMutex);
+        std::lock_guard<std::mutex> lock(this->channelMutex);
 
-        for (std::weak_ptr<Channel> &weak : this->channels.values()) {
-            std::shared_ptr<Channel> chan = weak.lock();
-            if (!chan) {
-                continue;
-            }
+        this->rebalanceReadConnections();
+    }
 
-            this->writeConnection->sendRaw("JOIN #" + chan->name);
-            this->readConnection->sendRaw("JOIN #" + chan->name);
-        }
+    //    if (this->hasSeperateWriteConnection()) {
+    {
+        std::lock_guard<std::mutex> lock(this->connectionMutex);
 
+        this->writeConnectionChannels.clear();
+        this->initializeConnection(this->writeConnection.get(), false, true);
         this->writeConnection->open();
-        this->readConnection->open();
     }
 
+    // the channels of a read connection are joined once it connected
+
+    for (size_t i = 0; i < this->readConnections.size(); i++) {
+        ReadConnection *readConnection = this->readConnections[i].get();
+
+        // the primary read connection also receives the messages that aren't sent to a channel
+        if (i == 0 || !readConnection->channelNames.isEmpty()) {
+            this->openReadConnection(readConnection);
+        }
+    }
+    //    } else {
+    //        this->initializeConnection(this->readConnection.get(), true, true);
+    //    }
+
     //    this->onConnected();
     // possbile event: started to connect
 }
 
 void AbstractIrcServer::disconnect()
 {
+    this->shouldBeConnected = false;
+
+    this->joinScheduler.clear();
+    this->joinTimer.stop();
+
+    for (auto &readConnection : this->readConnections) {
+        ReadConnection *closedConnection = readConnection.get();
+
+        closedConnection->isOpen = false;
+        this->postToReadThread(closedConnection, [closedConnection] {
+            closedConnection->isClosing = true;
+            closedConnection->connection->close();
+        });
+    }
+
     std::lock_guard<std::mutex> locker(this->connectionMutex);
 
-    this->readConnection->close();
     this->writeConnection->close();
 }
 
 void AbstractIrcServer::sendMessage(const QString &channelName, const QString &message)
+{
+    // fourtf: trim the message if it's sent from twitch chat
+
+    bool elevated = this->hasElevatedRights(channelName);
+    bool moderation = this->isModerationMessage(message);
+
+    {
+        std::lock_guard<std::mutex> locker(this->connectionMutex);
+
+        this->sendQueue.push({channelName, message, elevated}, moderation);
+    }
+
+    this->sendQueuedMessages();
+}
+
+int AbstractIrcServer::getReadConnectionCount() const
+{
+    return int(this->readConnections.size());
+}
+
+int AbstractIrcServer::getSendQueueSize()
 {
     std::lock_guard<std::mutex> locker(this->connectionMutex);
 
-    // fourtf: trim the message if it's sent from twitch chat
+    return this->sendQueue.size();
+}
+
+void AbstractIrcServer::sendQueuedMessages()
+{
+    std::lock_guard<std::mutex> locker(this->connectionMutex);
+
+    // messages wait while the write connection is down instead of getting lost
+    if (this->writeConnection && this->writeConnection->isConnected()) {
+        // the write connection joins a channel before the first message is sent there, these
+        // joins count against the same limit as the ones of the read connections
+        auto joinChannel = [this](const QString &channelName) {
+            if (this->writeConnectionChannels.contains(channelName)) {
+                return true;
+            }
+
+            if (!this->joinScheduler.takeUnqueued()) {
+                return false;
+            }
+
+            this->writeConnectionChannels.insert(channelName);
+            this->writeConnection->sendRaw("JOIN #" + channelName);
+
+            return true;
+        };
+
+        for (const SendQueue::Entry &entry : this->sendQueue.take(joinChannel)) {
+            this->writeConnection->sendRaw("PRIVMSG #" + entry.channelName + " :" +
+                                           entry.message);
+        }
+    }
 
-    if (this->writeConnection) {
-        this->writeConnection->sendRaw("PRIVMSG #" + channelName + " :" + message);
+    sendQueueDepth.set(this->sendQueue.size());
+
+    if (this->sendQueue.isEmpty()) {
+        this->sendTimer.stop();
+    } else if (!this->sendTimer.isActive()) {
+        this->sendTimer.start();
     }
 }
 
@@ -116,35 +227,61 @@ std::shared_ptr<Channel> AbstractIrcServer::getOrAddChannel(const QString &dirty
     QString clojuresInCppAreShit = channelName;
 
     this->channels.insert(channelName, chan);
-    chan->destroyed.connect([this, clojuresInCppAreShit] {
-        // fourtf: issues when the server itself is destroyed
 
-        debug::Log("[AbstractIrcServer::addChannel] {} was destroyed", clojuresInCppAreShit);
-        this->channels.remove(clojuresInCppAreShit);
+    ReadConnection *readConnection = this->getReadConnectionForChannel();
+    this->assignReadConnection(channelName, readConnection);
 
-        if (this->readConnection) {
-            this->readConnection->sendRaw("PART #" + clojuresInCppAreShit);
-        }
+    chan->destroyed.connect([this, clojuresInCppAreShit] {
+        // fourtf: issues when the server itself is destroyed
 
-        if (this->writeConnection) {
-            this->writeConnection->sendRaw("PART #" + clojuresInCppAreShit);
-        }
+        // the last reference can be dropped on any thread, even while channelMutex is locked
+        util::postToThread([this, clojuresInCppAreShit] {
+            this->removeChannel(clojuresInCppAreShit);  //
+        });
     });
 
     // join irc channel
+    if (readConnection->isOpen) {
+        this->scheduleJoins({channelName});
+    } else if (this->shouldBeConnected) {
+        this->openReadConnection(readConnection);
+    }
+
+    return chan;
+}
+
+void AbstractIrcServer::removeChannel(const QString &channelName)
+{
     {
-        std::lock_guard<std::mutex> lock2(this->connectionMutex);
+        std::lock_guard<std::mutex> lock(this->channelMutex);
 
-        if (this->readConnection) {
-            this->readConnection->sendRaw("JOIN #" + channelName);
+        // the channel was added again before this ran
+        auto it = this->channels.find(channelName);
+        if (it != this->channels.end() && !it.value().expired()) {
+            return;
         }
 
-        if (this->writeConnection) {
-            this->writeConnection->sendRaw("JOIN #" + channelName);
+        debug::Log("[AbstractIrcServer::removeChannel] {} was destroyed", channelName);
+        this->channels.remove(channelName);
+        this->joinScheduler.remove(channelName);
+
+        ReadConnection *readConnection = this->channelReadConnections.take(channelName);
+        if (readConnection) {
+            readConnection->channelNames.remove(channelName);
+
+            if (readConnection->isOpen) {
+                this->postToReadThread(readConnection, [readConnection, channelName] {
+                    readConnection->connection->sendRaw("PART #" + channelName);
+                });
+            }
         }
     }
 
-    return chan;
+    std::lock_guard<std::mutex> lock(this->connectionMutex);
+
+    if (this->writeConnection && this->writeConnectionChannels.remove(channelName)) {
+        this->writeConnection->sendRaw("PART #" + channelName);
+    }
 }
 
 std::shared_ptr<Channel> AbstractIrcServer::getChannelOrEmpty(const QString &dirtyChannelName)
@@ -172,15 +309,15 @@ std::shared_ptr<Channel> AbstractIrcServer::getChannelOrEmpty(const QString &dir
     return Channel::getEmpty();
 }
 
-void AbstractIrcServer::onConnected()
+void AbstractIrcServer::onConnected(const QStringList &channelNames)
 {
     std::lock_guard<std::mutex> lock(this->channelMutex);
 
     MessagePtr connMsg = Message::createSystemMessage("connected to chat");
     MessagePtr reconnMsg = Message::createSystemMessage("reconnected to chat");
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values()) {
-        std::shared_ptr<Channel> chan = weak.lock();
+    for (const QString &channelName : channelNames) {
+        std::shared_ptr<Channel> chan = this->channels.value(channelName).lock();
         if (!chan) {
             continue;
         }
@@ -200,15 +337,15 @@ void AbstractIrcServer::onConnected()
     }
 }
 
-void AbstractIrcServer::onDisconnected()
+void AbstractIrcServer::onDisconnected(const QStringList &channelNames)
 {
     std::lock_guard<std::mutex> lock(this->channelMutex);
 
     MessagePtr msg = Message::createSystemMessage("disconnected from chat");
     msg->flags |= Message::DisconnectedMessage;
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values()) {
-        std::shared_ptr<Channel> chan = weak.lock();
+    for (const QString &channelName : channelNames) {
+        std::shared_ptr<Channel> chan = this->channels.value(channelName).lock();
         if (!chan) {
             continue;
         }
@@ -229,9 +366,340 @@ QString AbstractIrcServer::cleanChannelName(const QString &dirtyChannelName)
 
 void AbstractIrcServer::addFakeMessage(const QString &data)
 {
-    auto fakeMessage = Communi::IrcMessage::fromData(data.toUtf8(), this->readConnection.get());
+    auto fakeMessage = Communi::IrcMessage::fromData(data.toUtf8(), nullptr);
+
+    this->addFakeMessage(fakeMessage);
+}
+
+void AbstractIrcServer::addFakeMessage(Communi::IrcMessage *message)
+{
+    this->dispatchMessage(message);
+}
+
+bool AbstractIrcServer::isMessageHandled(Communi::IrcMessage *message, bool isPrimaryConnection)
+{
+    return true;
+}
+
+int AbstractIrcServer::getMaxReadConnections()
+{
+    return 1;
+}
+
+int AbstractIrcServer::getChannelsPerReadConnection()
+{
+    return 100;
+}
+
+QSet<QString> AbstractIrcServer::getPrioritizedChannels()
+{
+    return QSet<QString>();
+}
+
+bool AbstractIrcServer::hasElevatedRights(const QString &channelName)
+{
+    return false;
+}
+
+bool AbstractIrcServer::isModerationMessage(const QString &message)
+{
+    return false;
+}
+
+AbstractIrcServer::ReadConnection *AbstractIrcServer::addReadConnection()
+{
+    ReadConnection *readConnection = new ReadConnection;
+    this->readConnections.emplace_back(readConnection);
+
+    bool isPrimaryConnection = this->readConnections.size() == 1;
+
+    readConnection->connection.reset(new Communi::IrcConnection);
+    readConnection->connection->moveToThread(&readConnection->thread);
+
+    QObject::connect(readConnection->connection.get(), &Communi::IrcConnection::messageReceived,
+                     [this, isPrimaryConnection](auto msg) {
+                         this->readMessageReceived(msg, isPrimaryConnection);
+                     });
+    QObject::connect(readConnection->connection.get(), &Communi::IrcConnection::connected,
+                     [this, readConnection] {
+                         util::postToThread([this, readConnection] {
+                             readConnection->isConnected = true;
+                             readConnection->reconnectAttempts = 0;
+
+                             QStringList channelNames = readConnection->channelNames.toList();
+                             this->onConnected(channelNames);
+                             this->scheduleJoins(channelNames);
+                         });
+                     });
+    QObject::connect(readConnection->connection.get(), &Communi::IrcConnection::disconnected,
+                     [this, readConnection] {
+                         bool unexpected = !readConnection->isClosing;
+
+                         util::postToThread([this, readConnection, unexpected] {
+                             this->readConnectionDisconnected(readConnection, unexpected);
+                         });
+                     });
+    // a connection attempt that fails doesn't always emit disconnected
+    QObject::connect(readConnection->connection.get(), &Communi::IrcConnection::socketError,
+                     [this, readConnection] {
+                         if (readConnection->isClosing) {
+                             return;
+                         }
+
+                         util::postToThread([this, readConnection] {
+                             this->readConnectionDisconnected(readConnection, true);
+                         });
+                     });
+
+    readConnection->thread.setObjectName(
+        QString("IRC read connection %1").arg(this->readConnections.size()));
+    readConnection->thread.start();
+
+    return readConnection;
+}
+
+AbstractIrcServer::ReadConnection *AbstractIrcServer::getReadConnectionForChannel()
+{
+    int maxConnections = std::max(1, this->getMaxReadConnections());
+    int channelsPerConnection = std::max(1, this->getChannelsPerReadConnection());
+
+    auto getTraffic = [this](ReadConnection *readConnection) {
+        double traffic = 0;
+
+        for (const QString &channelName : readConnection->channelNames) {
+            std::shared_ptr<Channel> chan = this->channels.value(channelName).lock();
+            if (chan) {
+                traffic += chan->statistics.getSnapshot().messagesPerSecond;
+            }
+        }
+
+        return traffic;
+    };
+
+    auto getLeastBusy = [&](bool skipFull) {
+        ReadConnection *leastBusy = nullptr;
+        double leastTraffic = 0;
+
+        size_t count = std::min(this->readConnections.size(), size_t(maxConnections));
+        for (size_t i = 0; i < count; i++) {
+            ReadConnection *readConnection = this->readConnections[i].get();
+
+            if (skipFull && readConnection->channelNames.size() >= channelsPerConnection) {
+                continue;
+            }
+
+            double traffic = getTraffic(readConnection);
+            if (leastBusy == nullptr || traffic < leastTraffic) {
+                leastBusy = readConnection;
+                leastTraffic = traffic;
+            }
+        }
+
+        return leastBusy;
+    };
+
+    ReadConnection *readConnection = getLeastBusy(true);
+    if (readConnection) {
+        return readConnection;
+    }
+
+    if (int(this->readConnections.size()) < maxConnections) {
+        return this->addReadConnection();
+    }
+
+    // every connection is full
+    return getLeastBusy(false);
+}
+
+void AbstractIrcServer::assignReadConnection(const QString &channelName,
+                                             ReadConnection *readConnection)
+{
+    readConnection->channelNames.insert(channelName);
+    this->channelReadConnections.insert(channelName, readConnection);
+}
+
+void AbstractIrcServer::rebalanceReadConnections()
+{
+    std::vector<std::pair<double, QString>> channelTraffic;
+
+    for (auto it = this->channels.begin(); it != this->channels.end(); ++it) {
+        std::shared_ptr<Channel> chan = it.value().lock();
+        if (!chan) {
+            continue;
+        }
+
+        channelTraffic.emplace_back(chan->statistics.getSnapshot().messagesPerSecond, it.key());
+    }
+
+    std::sort(channelTraffic.begin(), channelTraffic.end(),
+              [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    for (auto &readConnection : this->readConnections) {
+        readConnection->channelNames.clear();
+    }
+    this->channelReadConnections.clear();
+
+    for (const auto &pair : channelTraffic) {
+        this->assignReadConnection(pair.second, this->getReadConnectionForChannel());
+    }
+}
+
+void AbstractIrcServer::openReadConnection(ReadConnection *readConnection)
+{
+    readConnection->isOpen = true;
+
+    this->postToReadThread(readConnection, [this, readConnection] {
+        Communi::IrcConnection *connection = readConnection->connection.get();
+
+        if (connection->isActive()) {
+            readConnection->isClosing = true;
+            connection->close();
+        }
+
+        readConnection->isClosing = false;
+        this->initializeConnection(connection, true, false);
+        connection->open();
+    });
+}
+
+void AbstractIrcServer::scheduleJoins(const QStringList &channelNames)
+{
+    for (const QString &channelName : channelNames) {
+        this->joinScheduler.add(channelName);
+    }
+
+    this->sendScheduledJoins();
+}
+
+void AbstractIrcServer::sendScheduledJoins()
+{
+    QStringList channelNames =
+        this->joinScheduler.take(this->getPrioritizedChannels(), [this](const QString &name) {
+            ReadConnection *readConnection = this->channelReadConnections.value(name);
+
+            return readConnection != nullptr && readConnection->isConnected;
+        });
+
+    // one batch of comma separated joins per read connection
+    QMap<ReadConnection *, QStringList> batches;
+    for (const QString &channelName : channelNames) {
+        batches[this->channelReadConnections.value(channelName)].append(channelName);
+    }
+
+    for (auto it = batches.begin(); it != batches.end(); ++it) {
+        ReadConnection *readConnection = it.key();
+        QStringList lines = JoinScheduler::buildLines("JOIN", it.value());
+
+        this->postToReadThread(readConnection, [readConnection, lines] {
+            for (const QString &line : lines) {
+                readConnection->connection->sendRaw(line);
+            }
+        });
+    }
+
+    if (this->joinScheduler.isEmpty()) {
+        this->joinTimer.stop();
+    } else if (!this->joinTimer.isActive()) {
+        this->joinTimer.start();
+    }
+}
+
+void AbstractIrcServer::readConnectionDisconnected(ReadConnection *readConnection,
+                                                   bool unexpected)
+{
+    // failed reconnects don't post another disconnected message
+    if (readConnection->isConnected) {
+        readConnection->isConnected = false;
+
+        this->onDisconnected(readConnection->channelNames.toList());
+    }
+
+    if (!unexpected || !readConnection->isOpen) {
+        return;
+    }
+
+    // only this connection reconnects, the others keep receiving their channels
+    readConnection->isOpen = false;
+
+    // exponential backoff with up to 25% jitter, so shards that dropped together don't all
+    // reconnect at the same time
+    static std::mt19937 generator{std::random_device{}()};
+
+    int attempts = std::min(readConnection->reconnectAttempts++, 6);
+    int delay = std::min(minReconnectDelay << attempts, maxReconnectDelay);
+    delay += std::uniform_int_distribution<int>(0, delay / 4)(generator);
+
+    QTimer::singleShot(delay, [this, readConnection] {
+        if (this->shouldBeConnected && !readConnection->isOpen) {
+            this->openReadConnection(readConnection);
+        }
+    });
+}
+
+void AbstractIrcServer::postToReadThread(ReadConnection *readConnection,
+                                         std::function<void()> func)
+{
+    util::postToThread(
+        [readConnection, func] {
+            if (readConnection->connection) {
+                func();
+            }
+        },
+        readConnection->connection.get());
+}
+
+void AbstractIrcServer::readMessageReceived(Communi::IrcMessage *message,
+                                            bool isPrimaryConnection)
+{
+    util::tracing::Scope trace(util::tracing::Stage::IrcReceive);
+
+    if (!this->isMessageHandled(message, isPrimaryConnection)) {
+        return;
+    }
+
+    // communi deletes its message once the signal returns, so the gui thread gets a copy of the
+    // already parsed message
+    Communi::IrcMessage *copy = message->clone(nullptr);
+
+    copy->moveToThread(QCoreApplication::instance()->thread());
+
+    bool dispatchQueued;
+    {
+        std::lock_guard<std::mutex> lock(this->pendingMessagesMutex);
+
+        dispatchQueued = !this->pendingMessages.empty();
+        this->pendingMessages.push_back(copy);
+    }
+
+    // a burst of messages is handed to the gui thread as a single event
+    if (!dispatchQueued) {
+        util::postToThread([this] { this->dispatchPendingMessages(); });
+    }
+}
+
+void AbstractIrcServer::dispatchPendingMessages()
+{
+    std::vector<Communi::IrcMessage *> messages;
+    {
+        std::lock_guard<std::mutex> lock(this->pendingMessagesMutex);
+
+        std::swap(messages, this->pendingMessages);
+    }
+
+    for (Communi::IrcMessage *message : messages) {
+        this->dispatchMessage(message);
+    }
+}
+
+void AbstractIrcServer::dispatchMessage(Communi::IrcMessage *message)
+{
+    this->messageReceived(message);
+
+    if (message->type() == Communi::IrcMessage::Private) {
+        this->privateMessageReceived(static_cast<Communi::IrcPrivateMessage *>(message));
+    }
 
-    this->privateMessageReceived(qobject_cast<Communi::IrcPrivateMessage *>(fakeMessage));
+    delete message;
 }
 
 void AbstractIrcServer::privateMessageReceived(Communi::IrcPrivateMessage *message)
@@ -1,13 +1,19 @@
 #pragma once
 
 #include "channel.hpp"
+#include "providers/irc/joinscheduler.hpp"
+#include "providers/irc/sendqueue.hpp"
 
 #include <IrcConnection>
 #include <IrcMessage>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
 #include <pajlada/signals/signal.hpp>
 
 #include <functional>
 #include <mutex>
+#include <vector>
 
 namespace chatterino {
 namespace providers {
@@ -16,16 +22,18 @@ namespace irc {
 class AbstractIrcServer
 {
 public:
-    virtual ~AbstractIrcServer() = default;
+    virtual ~AbstractIrcServer();
 
     // connection
-    Communi::IrcConnection *getReadConnection() const;
-
     void connect();
     void disconnect();
 
+    // Queues a message, messages are sent as fast as the rate limits of the server allow
     void sendMessage(const QString &channelName, const QString &message);
 
+    int getReadConnectionCount() const;
+    int getSendQueueSize();
+
     // channels
     std::shared_ptr<Channel> getOrAddChannel(const QString &dirtyChannelName);
     std::shared_ptr<Channel> getChannelOrEmpty(const QString &dirtyChannelName);
@@ -36,6 +44,8 @@ public:
     pajlada::Signals::Signal<Communi::IrcPrivateMessage *> onPrivateMessage;
 
     void addFakeMessage(const QString &data);
+    // Dispatches a parsed message as if it was received on the read connection. Takes ownership
+    void addFakeMessage(Communi::IrcMessage *message);
 
     // iteration
     void forEachChannel(std::function<void(ChannelPtr)> func);
@@ -43,16 +53,38 @@ public:
 protected:
     AbstractIrcServer();
 
+    // Called on the gui thread for the write connection and on their own thread for the read
+    // connections
     virtual void initializeConnection(Communi::IrcConnection *connection, bool isRead,
                                       bool isWrite) = 0;
     virtual std::shared_ptr<Channel> createChannel(const QString &channelName) = 0;
 
+    // Called on the thread of the read connection. Messages that are not handled are dropped
+    // before they reach the gui thread. Messages that aren't sent to a channel are received on
+    // every read connection and should only be handled on the primary one.
+    virtual bool isMessageHandled(Communi::IrcMessage *message, bool isPrimaryConnection);
+
+    // Channels are spread over up to getMaxReadConnections() read connections with up to
+    // getChannelsPerReadConnection() channels each
+    virtual int getMaxReadConnections();
+    virtual int getChannelsPerReadConnection();
+
+    // Channels that are joined before the others, e.g. the ones that are currently visible
+    virtual QSet<QString> getPrioritizedChannels();
+
+    // Messages to channels where the user has elevated rights are sent at the higher rate limit
+    virtual bool hasElevatedRights(const QString &channelName);
+
+    // Moderation messages skip ahead of the other queued messages
+    virtual bool isModerationMessage(const QString &message);
+
     virtual void privateMessageReceived(Communi::IrcPrivateMessage *message);
     virtual void messageReceived(Communi::IrcMessage *message);
     virtual void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
-    virtual void onConnected();
-    virtual void onDisconnected();
+    // Called when a read connection (re)connected or disconnected, with the channels it joins
+    virtual void onConnected(const QStringList &channelNames);
+    virtual void onDisconnected(const QStringList &channelNames);
 
     virtual std::shared_ptr<Channel> getCustomChannel(const QString &channelName);
 
@@ -62,10 +94,70 @@ protected:
     std::mutex channelMutex;
 
 private:
+    // A read connection with its own thread. Socket i/o and parsing happen on that thread, the
+    // other members are only used on the gui thread.
+    struct ReadConnection {
+        std::unique_ptr<Communi::IrcConnection> connection;
+        QThread thread;
+
+        QSet<QString> channelNames;
+        bool isOpen = false;
+        bool isConnected = false;
+
+        // reconnects since the connection was last connected, the delay doubles with each one
+        int reconnectAttempts = 0;
+
+        // only used on the thread of the connection, set while it is closed on purpose
+        bool isClosing = false;
+    };
+
     void initConnection();
 
+    ReadConnection *addReadConnection();
+
+    // Picks the read connection for a new channel: the least busy one that isn't full, or a new
+    // one while there are less than the maximum. channelMutex has to be locked.
+    ReadConnection *getReadConnectionForChannel();
+    void assignReadConnection(const QString &channelName, ReadConnection *readConnection);
+
+    // Forgets a channel that was destroyed, runs on the gui thread
+    void removeChannel(const QString &channelName);
+
+    // Spreads all channels over the read connections again, busiest channels first
+    void rebalanceReadConnections();
+
+    void openReadConnection(ReadConnection *readConnection);
+    void scheduleJoins(const QStringList &channelNames);
+    void sendScheduledJoins();
+    void sendQueuedMessages();
+    void readConnectionDisconnected(ReadConnection *readConnection, bool unexpected);
+
+    // Runs func on the thread of the read connection, the connection may only be used there
+    void postToReadThread(ReadConnection *readConnection, std::function<void()> func);
+
+    void readMessageReceived(Communi::IrcMessage *message, bool isPrimaryConnection);
+    void dispatchPendingMessages();
+    void dispatchMessage(Communi::IrcMessage *message);
+
     std::unique_ptr<Communi::IrcConnection> writeConnection = nullptr;
-    std::unique_ptr<Communi::IrcConnection> readConnection = nullptr;
+
+    // the write connection only joins the channels messages are sent to
+    QSet<QString> writeConnectionChannels;
+
+    SendQueue sendQueue;
+    QTimer sendTimer;
+
+    // the first one is the primary read connection and always exists
+    std::vector<std::unique_ptr<ReadConnection>> readConnections;
+    QMap<QString, ReadConnection *> channelReadConnections;
+    bool shouldBeConnected = false;
+
+    JoinScheduler joinScheduler;
+    QTimer joinTimer;
+
+    // parsed on the read threads, waiting to be dispatched on the gui thread
+    std::vector<Communi::IrcMessage *> pendingMessages;
+    std::mutex pendingMessagesMutex;
 
     std::mutex connectionMutex;
 };
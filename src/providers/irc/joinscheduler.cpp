@@ -0,0 +1,139 @@
+#include "providers/irc/joinscheduler.hpp"
+
+#include <chrono>
+
+namespace chatterino {
+namespace providers {
+namespace irc {
+
+namespace {
+
+// 512 bytes including the trailing "\r\n"
+const int maxLineLength = 510;
+
+int64_t currentMilliseconds()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+JoinScheduler::JoinScheduler(int _joinsPerPeriod, int64_t _periodMilliseconds)
+    : joinsPerPeriod(_joinsPerPeriod)
+    , periodMilliseconds(_periodMilliseconds)
+{
+}
+
+void JoinScheduler::add(const QString &channelName)
+{
+    if (this->pendingSet.contains(channelName)) {
+        return;
+    }
+
+    this->pending.append(channelName);
+    this->pendingSet.insert(channelName);
+}
+
+void JoinScheduler::remove(const QString &channelName)
+{
+    if (this->pendingSet.remove(channelName)) {
+        this->pending.removeOne(channelName);
+    }
+}
+
+void JoinScheduler::clear()
+{
+    this->pending.clear();
+    this->pendingSet.clear();
+}
+
+bool JoinScheduler::isEmpty() const
+{
+    return this->pending.isEmpty();
+}
+
+QStringList JoinScheduler::take(const QSet<QString> &prioritized,
+                                const std::function<bool(const QString &)> &canJoin)
+{
+    int64_t now = currentMilliseconds();
+
+    this->expire(now);
+
+    int budget = this->joinsPerPeriod - int(this->sentTimes.size());
+
+    QStringList taken;
+
+    auto takeMatching = [&](bool takePrioritized) {
+        for (auto it = this->pending.begin(); it != this->pending.end() && budget > 0;) {
+            if (prioritized.contains(*it) != takePrioritized || !canJoin(*it)) {
+                ++it;
+                continue;
+            }
+
+            taken.append(*it);
+            this->pendingSet.remove(*it);
+            it = this->pending.erase(it);
+
+            this->sentTimes.push_back(now);
+            budget--;
+        }
+    };
+
+    takeMatching(true);
+    takeMatching(false);
+
+    return taken;
+}
+
+bool JoinScheduler::takeUnqueued()
+{
+    int64_t now = currentMilliseconds();
+
+    this->expire(now);
+
+    if (int(this->sentTimes.size()) >= this->joinsPerPeriod) {
+        return false;
+    }
+
+    this->sentTimes.push_back(now);
+
+    return true;
+}
+
+void JoinScheduler::expire(int64_t now)
+{
+    while (!this->sentTimes.empty() && this->sentTimes.front() <= now - this->periodMilliseconds) {
+        this->sentTimes.pop_front();
+    }
+}
+
+QStringList JoinScheduler::buildLines(const QString &command, const QStringList &channelNames)
+{
+    QStringList lines;
+    QString line;
+
+    for (const QString &channelName : channelNames) {
+        if (!line.isEmpty() && line.length() + 2 + channelName.length() > maxLineLength) {
+            lines.append(line);
+            line.clear();
+        }
+
+        if (line.isEmpty()) {
+            line = command + " #" + channelName;
+        } else {
+            line += ",#" + channelName;
+        }
+    }
+
+    if (!line.isEmpty()) {
+        lines.append(line);
+    }
+
+    return lines;
+}
+
+}  // namespace irc
+}  // namespace providers
+}  // namespace chatterino
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace chatterino {
+namespace providers {
+namespace irc {
+
+// Channels waiting to be joined. Joins are handed out within a limit of joins per period, channels
+// that are prioritized go first, the others in the order they were added.
+class JoinScheduler
+{
+public:
+    JoinScheduler(int joinsPerPeriod, int64_t periodMilliseconds);
+
+    void add(const QString &channelName);
+    void remove(const QString &channelName);
+    void clear();
+
+    bool isEmpty() const;
+
+    // Takes the channels that may be joined now and counts them against the limit. Channels that
+    // canJoin returns false for stay queued.
+    QStringList take(const QSet<QString> &prioritized,
+                     const std::function<bool(const QString &)> &canJoin);
+
+    // Counts a join that is sent without being queued against the same limit. Returns false if
+    // the limit is reached, the join has to be retried later then.
+    bool takeUnqueued();
+
+    // "JOIN #a,#b,..." lines that don't exceed the maximum line length of the server
+    static QStringList buildLines(const QString &command, const QStringList &channelNames);
+
+private:
+    int joinsPerPeriod;
+    int64_t periodMilliseconds;
+
+    QStringList pending;
+    QSet<QString> pendingSet;
+
+    // when the joins of the current period were sent
+    std::deque<int64_t> sentTimes;
+
+    // Forgets the joins that are older than the period
+    void expire(int64_t now);
+};
+
+}  // namespace irc
+}  // namespace providers
+}  // namespace chatterino
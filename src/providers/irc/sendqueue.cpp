@@ -0,0 +1,121 @@
+#include "providers/irc/sendqueue.hpp"
+
+#include <QSet>
+
+#include <chrono>
+
+namespace chatterino {
+namespace providers {
+namespace irc {
+
+namespace {
+
+int64_t currentMilliseconds()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+SendQueue::SendWindow::SendWindow(int _limit, int64_t _periodMilliseconds)
+    : limit(_limit)
+    , periodMilliseconds(_periodMilliseconds)
+{
+}
+
+void SendQueue::SendWindow::expire(int64_t now)
+{
+    while (!this->sentTimes.empty() && this->sentTimes.front() <= now - this->periodMilliseconds) {
+        this->sentTimes.pop_front();
+    }
+}
+
+bool SendQueue::SendWindow::canSend() const
+{
+    return int(this->sentTimes.size()) < this->limit;
+}
+
+void SendQueue::SendWindow::add(int64_t now)
+{
+    this->sentTimes.push_back(now);
+}
+
+SendQueue::SendQueue(int regularLimit, int elevatedLimit, int64_t periodMilliseconds)
+    : regularWindow(regularLimit, periodMilliseconds)
+    , elevatedWindow(elevatedLimit, periodMilliseconds)
+{
+}
+
+void SendQueue::push(Entry entry, bool moderation)
+{
+    if (moderation) {
+        this->moderationLane.push_back(std::move(entry));
+    } else {
+        this->normalLane.push_back(std::move(entry));
+    }
+}
+
+void SendQueue::clear()
+{
+    this->moderationLane.clear();
+    this->normalLane.clear();
+}
+
+int SendQueue::size() const
+{
+    return int(this->moderationLane.size() + this->normalLane.size());
+}
+
+bool SendQueue::isEmpty() const
+{
+    return this->moderationLane.empty() && this->normalLane.empty();
+}
+
+std::vector<SendQueue::Entry> SendQueue::take(
+    const std::function<bool(const QString &)> &prepareChannel)
+{
+    int64_t now = currentMilliseconds();
+
+    this->regularWindow.expire(now);
+    this->elevatedWindow.expire(now);
+
+    std::vector<Entry> taken;
+
+    this->takeFrom(this->moderationLane, taken, now, prepareChannel);
+    this->takeFrom(this->normalLane, taken, now, prepareChannel);
+
+    return taken;
+}
+
+void SendQueue::takeFrom(std::deque<Entry> &lane, std::vector<Entry> &taken, int64_t now,
+                         const std::function<bool(const QString &)> &prepareChannel)
+{
+    // once a message of a channel has to wait, the later ones of that channel wait as well
+    QSet<QString> blockedChannels;
+
+    for (auto it = lane.begin(); it != lane.end() && this->elevatedWindow.canSend();) {
+        bool canSend = !blockedChannels.contains(it->channelName) &&
+                       (it->elevated || this->regularWindow.canSend()) &&
+                       prepareChannel(it->channelName);
+
+        if (!canSend) {
+            blockedChannels.insert(it->channelName);
+            ++it;
+            continue;
+        }
+
+        this->elevatedWindow.add(now);
+        if (!it->elevated) {
+            this->regularWindow.add(now);
+        }
+
+        taken.push_back(std::move(*it));
+        it = lane.erase(it);
+    }
+}
+
+}  // namespace irc
+}  // namespace providers
+}  // namespace chatterino
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace chatterino {
+namespace providers {
+namespace irc {
+
+// Messages waiting to be sent on a write connection. Sending is limited by two sliding windows:
+// every message counts against the limit of users with elevated rights, messages to channels
+// without elevated rights also against the smaller limit of regular users. No period ever
+// contains more sends than a limit allows. Moderation messages go ahead of the others, messages
+// to the same channel keep their order.
+class SendQueue
+{
+public:
+    struct Entry {
+        QString channelName;
+        QString message;
+        bool elevated;
+    };
+
+    SendQueue(int regularLimit, int elevatedLimit, int64_t periodMilliseconds);
+
+    void push(Entry entry, bool moderation);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const;
+
+    // Takes the messages that may be sent now, in the order they should be sent. prepareChannel
+    // is called before a message to a channel is taken, the messages to channels it returns
+    // false for stay queued.
+    std::vector<Entry> take(const std::function<bool(const QString &)> &prepareChannel);
+
+private:
+    class SendWindow
+    {
+    public:
+        SendWindow(int limit, int64_t periodMilliseconds);
+
+        // Forgets the sends that are older than the period
+        void expire(int64_t now);
+        bool canSend() const;
+        void add(int64_t now);
+
+    private:
+        int limit;
+        int64_t periodMilliseconds;
+
+        // when the sends of the current period happened
+        std::deque<int64_t> sentTimes;
+    };
+
+    void takeFrom(std::deque<Entry> &lane, std::vector<Entry> &taken, int64_t now,
+                  const std::function<bool(const QString &)> &prepareChannel);
+
+    std::deque<Entry> moderationLane;
+    std::deque<Entry> normalLane;
+
+    SendWindow regularWindow;
+    SendWindow elevatedWindow;
+};
+
+}  // namespace irc
+}  // namespace providers
+}  // namespace chatterino
@@ -4,11 +4,14 @@
 #include "providers/twitch/pubsubactions.hpp"
 #include "providers/twitch/pubsubhelpers.hpp"
 #include "singletons/accountmanager.hpp"
+#include "util/posttothread.hpp"
 #include "util/rapidjson-helpers.hpp"
 
 #include <rapidjson/error/en.h>
 
+#include <algorithm>
 #include <exception>
+#include <random>
 #include <thread>
 
 #define TWITCH_PUBSUB_URL "wss://pubsub-edge.twitch.tv"
@@ -25,6 +28,10 @@ static const char *pingPayload = "{\"type\":\"PING\"}";
 
 static std::map<std::string, std::string> sentMessages;
 
+// delay before connecting again after a connection failed or dropped, doubled with every failure
+static const int minReconnectDelay = 1000;
+static const int maxReconnectDelay = 120000;
+
 namespace detail {
 
 PubSubClient::PubSubClient(WebsocketClient &_websocketClient, WebsocketHandle _handle)
@@ -60,8 +67,12 @@ bool PubSubClient::listen(rapidjson::Document &message)
 
     this->numListens += numRequestedListens;
 
+    QString authToken;
+    rj::getSafe(message["data"], "auth_token", authToken);
+
     for (const auto &topic : message["data"]["topics"].GetArray()) {
-        this->listeners.emplace_back(Listener{topic.GetString(), false, false, false});
+        this->listeners.emplace_back(
+            Listener{topic.GetString(), !authToken.isEmpty(), false, false, authToken});
     }
 
     auto uuid = CreateUUID();
@@ -94,6 +105,8 @@ void PubSubClient::unlistenPrefix(const std::string &prefix)
         return;
     }
 
+    this->numListens -= topics.size();
+
     auto message = createUnlistenMessage(topics);
 
     auto uuid = CreateUUID();
@@ -126,6 +139,33 @@ bool PubSubClient::isListeningToTopic(const std::string &payload)
     return false;
 }
 
+const std::vector<Listener> &PubSubClient::getListeners() const
+{
+    return this->listeners;
+}
+
+void PubSubClient::close(const std::string &reason)
+{
+    this->closing = true;
+
+    WebsocketErrorCode ec;
+    this->websocketClient.close(this->handle, websocketpp::close::status::going_away, reason, ec);
+
+    if (ec) {
+        debug::Log("Error closing pubsub connection: {}", ec.message());
+    }
+}
+
+bool PubSubClient::isClosing() const
+{
+    return this->closing;
+}
+
+bool PubSubClient::hasTimedOut() const
+{
+    return this->timedOut;
+}
+
 void PubSubClient::ping()
 {
     assert(this->started);
@@ -144,8 +184,9 @@ void PubSubClient::ping()
         }
 
         if (self->awaitingPong) {
-            debug::Log("No pong respnose, disconnect!");
-            // TODO(pajlada): Label this connection as "disconnect me"
+            debug::Log("No pong response, disconnect!");
+            self->timedOut = true;
+            self->close("No pong response");
         }
     });
 
@@ -460,6 +501,7 @@ PubSub::PubSub()
     this->websocketClient.set_message_handler(bind(&PubSub::onMessage, this, ::_1, ::_2));
     this->websocketClient.set_open_handler(bind(&PubSub::onConnectionOpen, this, ::_1));
     this->websocketClient.set_close_handler(bind(&PubSub::onConnectionClose, this, ::_1));
+    this->websocketClient.set_fail_handler(bind(&PubSub::onConnectionFail, this, ::_1));
 
     // Add an initial client
     this->addClient();
@@ -472,12 +514,76 @@ void PubSub::addClient()
 
     if (ec) {
         debug::Log("Unable to establish connection: {}", ec.message());
+        this->connectionFailed();
         return;
     }
 
+    this->pendingConnections++;
+
     this->websocketClient.connect(con);
 }
 
+void PubSub::ensureClients()
+{
+    if (this->pendingConnections > 0 || this->connectScheduled) {
+        return;
+    }
+
+    if (!this->clients.empty() && this->requests.empty()) {
+        return;
+    }
+
+    if (int(this->clients.size()) >= MAX_PUBSUB_CONNECTIONS) {
+        debug::Log("All {} pubsub connections are full, {} requests are waiting",
+                   this->clients.size(), this->requests.size());
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    if (now >= this->nextConnectTime) {
+        this->addClient();
+        return;
+    }
+
+    this->connectScheduled = true;
+
+    runAfter(this->websocketClient.get_io_service(), this->nextConnectTime - now, [this](auto) {
+        this->connectScheduled = false;
+        this->ensureClients();
+    });
+}
+
+void PubSub::connectionFailed()
+{
+    static std::mt19937 generator{std::random_device{}()};
+
+    // the jitter keeps clients that dropped together from reconnecting at the same time
+    int attempts = std::min(this->connectionFailures++, 7);
+    int delay = std::min(minReconnectDelay << attempts, maxReconnectDelay);
+    delay += std::uniform_int_distribution<int>(0, delay / 4)(generator);
+
+    this->nextConnectTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay);
+
+    this->ensureClients();
+}
+
+void PubSub::drainRequests()
+{
+    for (auto it = this->requests.begin(); it != this->requests.end();) {
+        if (this->tryListen(**it)) {
+            it = this->requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PubSub::postToWebsocketThread(std::function<void()> func)
+{
+    this->websocketClient.get_io_service().post(func);
+}
+
 void PubSub::start()
 {
     this->mainThread.reset(new std::thread(std::bind(&PubSub::runThread, this)));
@@ -489,25 +595,34 @@ void PubSub::listenToWhispers(std::shared_ptr<providers::twitch::TwitchAccount>
 
     std::string userID = account->getUserId().toStdString();
 
-    debug::Log("Connection open!");
-    websocketpp::lib::error_code ec;
-
     std::vector<std::string> topics({"whispers." + userID});
 
-    this->listen(std::move(createListenMessage(topics, account)));
+    auto message = std::make_shared<rapidjson::Document>(createListenMessage(topics, account));
 
-    if (ec) {
-        debug::Log("Unable to send message to websocket server: {}", ec.message());
-        return;
-    }
+    this->postToWebsocketThread([this, message] { this->listen(std::move(*message)); });
 }
 
 void PubSub::unlistenAllModerationActions()
 {
-    for (const auto &p : this->clients) {
-        const auto &client = p.second;
-        client->unlistenPrefix("chat_moderator_actions.");
-    }
+    this->postToWebsocketThread([this] {
+        for (const auto &p : this->clients) {
+            const auto &client = p.second;
+            client->unlistenPrefix("chat_moderator_actions.");
+        }
+
+        // requests that are still waiting are dropped as well
+        this->requests.erase(
+            std::remove_if(this->requests.begin(), this->requests.end(),
+                           [](const auto &request) {
+                               const auto &topics = (*request)["data"]["topics"];
+                               return topics.Size() > 0 &&
+                                      std::string(topics[0].GetString())
+                                              .find("chat_moderator_actions.") == 0;
+                           }),
+            this->requests.end());
+
+        this->ensureClients();
+    });
 }
 
 void PubSub::listenToChannelModerationActions(
@@ -520,14 +635,16 @@ void PubSub::listenToChannelModerationActions(
 
     std::string topic(fS("chat_moderator_actions.{}.{}", userID, channelID));
 
-    if (this->isListeningToTopic(topic)) {
-        debug::Log("We are already listening to topic {}", topic);
-        return;
-    }
+    this->postToWebsocketThread([this, topic, account] {
+        if (this->isListeningToTopic(topic)) {
+            debug::Log("We are already listening to topic {}", topic);
+            return;
+        }
 
-    debug::Log("Listen to topic {}", topic);
+        debug::Log("Listen to topic {}", topic);
 
-    this->listenToTopic(topic, account);
+        this->listenToTopic(topic, account);
+    });
 }
 
 void PubSub::listenToTopic(const std::string &topic,
@@ -540,13 +657,15 @@ void PubSub::listenToTopic(const std::string &topic,
 
 void PubSub::listen(rapidjson::Document &&msg)
 {
-    if (this->tryListen(msg)) {
+    if (this->requests.empty() && this->tryListen(msg)) {
         debug::Log("Successfully listened!");
         return;
     }
 
     debug::Log("Added to the back of the queue");
     this->requests.emplace_back(std::make_unique<rapidjson::Document>(std::move(msg)));
+
+    this->ensureClients();
 }
 
 bool PubSub::tryListen(rapidjson::Document &msg)
@@ -571,6 +690,14 @@ bool PubSub::isListeningToTopic(const std::string &topic)
         }
     }
 
+    for (const auto &request : this->requests) {
+        for (const auto &requestedTopic : (*request)["data"]["topics"].GetArray()) {
+            if (topic == requestedTopic.GetString()) {
+                return true;
+            }
+        }
+    }
+
     return false;
 }
 
@@ -626,6 +753,12 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl, WebsocketMessagePtr webs
         auto &client = *clientIt;
 
         client.second->handlePong();
+    } else if (type == "RECONNECT") {
+        // twitch is about to close the connection, a new one takes over its topics right away
+        auto clientIt = this->clients.find(hdl);
+        if (clientIt != this->clients.end()) {
+            clientIt->second->close("Reconnect requested");
+        }
     } else {
         debug::Log("Unknown message type: {}", type);
     }
@@ -640,6 +773,12 @@ void PubSub::onConnectionOpen(WebsocketHandle hdl)
 
     this->clients.emplace(hdl, client);
 
+    this->pendingConnections--;
+    this->connectionFailures = 0;
+
+    this->drainRequests();
+    this->ensureClients();
+
     this->connected.invoke();
 }
 
@@ -651,15 +790,82 @@ void PubSub::onConnectionClose(WebsocketHandle hdl)
     // code KKona
     assert(clientIt != this->clients.end());
 
-    auto &client = clientIt->second;
+    auto client = clientIt->second;
 
     client->stop();
 
     this->clients.erase(clientIt);
 
+    // the topics of the client are listened to again, by clients with room or a new one. They go
+    // ahead of the waiting requests since they were listened to before.
+    std::map<QString, std::vector<std::string>> topicsByToken;
+    for (const auto &listener : client->getListeners()) {
+        topicsByToken[listener.authToken].push_back(listener.topic);
+    }
+
+    std::vector<std::unique_ptr<rapidjson::Document>> rebalanced;
+    for (const auto &p : topicsByToken) {
+        for (size_t i = 0; i < p.second.size(); i += MAX_PUBSUB_LISTENS) {
+            std::vector<std::string> topics(
+                p.second.begin() + i,
+                p.second.begin() + std::min(i + MAX_PUBSUB_LISTENS, p.second.size()));
+
+            rebalanced.emplace_back(
+                std::make_unique<rapidjson::Document>(createListenMessage(topics, p.first)));
+        }
+    }
+
+    this->requests.insert(this->requests.begin(), std::make_move_iterator(rebalanced.begin()),
+                          std::make_move_iterator(rebalanced.end()));
+
+    this->drainRequests();
+
+    // planned closes and reconnects requested by twitch don't count as failures
+    if (this->isUnexpectedClose(hdl, *client)) {
+        this->connectionFailed();
+    } else {
+        this->ensureClients();
+    }
+
     this->connected.invoke();
 }
 
+bool PubSub::isUnexpectedClose(WebsocketHandle hdl, const detail::PubSubClient &client)
+{
+    if (client.hasTimedOut()) {
+        return true;
+    }
+
+    if (client.isClosing()) {
+        return false;
+    }
+
+    WebsocketErrorCode ec;
+    auto connection = this->websocketClient.get_con_from_hdl(hdl, ec);
+    if (ec) {
+        return true;
+    }
+
+    switch (connection->get_remote_close_code()) {
+        case websocketpp::close::status::normal:
+        case websocketpp::close::status::going_away:
+        case websocketpp::close::status::service_restart:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+void PubSub::onConnectionFail(WebsocketHandle hdl)
+{
+    debug::Log("PubSub connection failed");
+
+    this->pendingConnections--;
+
+    this->connectionFailed();
+}
+
 PubSub::WebsocketContextPtr PubSub::onTLSInit(websocketpp::connection_hdl hdl)
 {
     WebsocketContextPtr ctx(new boost::asio::ssl::context(boost::asio::ssl::context::tlsv1));
@@ -710,6 +916,27 @@ void PubSub::handleMessageResponse(const rapidjson::Value &outerData)
         return;
     }
 
+    this->pendingMessages.push(PendingMessage{topic, std::move(payload)});
+
+    // only post when no dispatch is pending, bursts of messages are dispatched together
+    if (!this->dispatchScheduled.exchange(true)) {
+        util::postToThread([this] { this->dispatchPendingMessages(); });
+    }
+}
+
+void PubSub::dispatchPendingMessages()
+{
+    // cleared before draining, messages pushed from now on schedule another dispatch
+    this->dispatchScheduled.store(false);
+
+    PendingMessage message;
+    while (this->pendingMessages.pop(message)) {
+        this->dispatchMessage(message.topic, message.payload);
+    }
+}
+
+void PubSub::dispatchMessage(const QString &topic, const std::string &payload)
+{
     rapidjson::Document msg;
 
     rapidjson::ParseResult res = msg.Parse(payload.c_str());
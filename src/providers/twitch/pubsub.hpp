@@ -3,6 +3,7 @@
 #include "providers/twitch/pubsubactions.hpp"
 #include "providers/twitch/twitchaccount.hpp"
 #include "providers/twitch/twitchserver.hpp"
+#include "util/spscqueue.hpp"
 
 #include <rapidjson/document.h>
 #include <QString>
@@ -12,6 +13,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -38,6 +40,9 @@ struct Listener {
     bool authed;
     bool persistent;
     bool confirmed = false;
+
+    // kept to listen again on another client if this one disconnects
+    QString authToken;
 };
 
 class PubSubClient : public std::enable_shared_from_this<PubSubClient>
@@ -51,6 +56,10 @@ class PubSubClient : public std::enable_shared_from_this<PubSubClient>
     std::atomic<bool> awaitingPong{false};
     std::atomic<bool> started{false};
 
+    // set when the connection is closed on purpose, timedOut also when no pong arrived
+    std::atomic<bool> closing{false};
+    std::atomic<bool> timedOut{false};
+
 public:
     PubSubClient(WebsocketClient &_websocketClient, WebsocketHandle _handle);
 
@@ -64,6 +73,15 @@ public:
 
     bool isListeningToTopic(const std::string &topic);
 
+    const std::vector<Listener> &getListeners() const;
+
+    // Closes the connection, the topics are listened to again by PubSub::onConnectionClose
+    void close(const std::string &reason);
+
+    // Whether the connection was closed on purpose and not because it stopped responding
+    bool isClosing() const;
+    bool hasTimedOut() const;
+
 private:
     void ping();
     bool send(const char *payload);
@@ -126,6 +144,7 @@ public:
     void listenToChannelModerationActions(
         const QString &channelID, std::shared_ptr<providers::twitch::TwitchAccount> account);
 
+    // Listen requests that didn't fit into any client, they are sent once a client has room
     std::vector<std::unique_ptr<rapidjson::Document>> requests;
 
 private:
@@ -139,8 +158,27 @@ private:
 
     void addClient();
 
+    // Connects another client while requests are waiting or there is none. After failed
+    // connections this waits with a jittered exponential backoff.
+    void ensureClients();
+    void connectionFailed();
+
+    // Closes that weren't planned by either side delay the next connection
+    bool isUnexpectedClose(WebsocketHandle hdl, const detail::PubSubClient &client);
+
+    // Moves waiting requests into clients that have room, in the order they were made
+    void drainRequests();
+
+    // Runs func on the websocket thread, which owns the clients and requests
+    void postToWebsocketThread(std::function<void()> func);
+
     State state = State::Connected;
 
+    int pendingConnections = 0;
+    int connectionFailures = 0;
+    bool connectScheduled = false;
+    std::chrono::steady_clock::time_point nextConnectTime;
+
     std::map<WebsocketHandle, std::shared_ptr<detail::PubSubClient>,
              std::owner_less<WebsocketHandle>>
         clients;
@@ -151,11 +189,25 @@ private:
     void onMessage(websocketpp::connection_hdl hdl, WebsocketMessagePtr msg);
     void onConnectionOpen(websocketpp::connection_hdl hdl);
     void onConnectionClose(websocketpp::connection_hdl hdl);
+    void onConnectionFail(websocketpp::connection_hdl hdl);
     WebsocketContextPtr onTLSInit(websocketpp::connection_hdl hdl);
 
     void handleListenResponse(const rapidjson::Document &msg);
     void handleMessageResponse(const rapidjson::Value &data);
 
+    // MESSAGE responses are handed from the websocket thread to the gui thread, which parses
+    // their payload and invokes the signals
+    struct PendingMessage {
+        QString topic;
+        std::string payload;
+    };
+
+    util::SpscQueue<PendingMessage> pendingMessages;
+    std::atomic<bool> dispatchScheduled{false};
+
+    void dispatchPendingMessages();
+    void dispatchMessage(const QString &topic, const std::string &payload);
+
     void runThread();
 };
 
@@ -36,6 +36,12 @@ bool getTargetUser(const rapidjson::Value &data, ActionUser &user)
 
 rapidjson::Document createListenMessage(const std::vector<std::string> &topicsVec,
                                         std::shared_ptr<providers::twitch::TwitchAccount> account)
+{
+    return createListenMessage(topicsVec, account ? account->getOAuthToken() : QString());
+}
+
+rapidjson::Document createListenMessage(const std::vector<std::string> &topicsVec,
+                                        const QString &authToken)
 {
     rapidjson::Document msg(rapidjson::kObjectType);
     auto &a = msg.GetAllocator();
@@ -44,8 +50,8 @@ rapidjson::Document createListenMessage(const std::vector<std::string> &topicsVe
 
     rapidjson::Value data(rapidjson::kObjectType);
 
-    if (account) {
-        rj::set(data, "auth_token", account->getOAuthToken(), a);
+    if (!authToken.isEmpty()) {
+        rj::set(data, "auth_token", authToken, a);
     }
 
     rapidjson::Value topics(rapidjson::kArrayType);
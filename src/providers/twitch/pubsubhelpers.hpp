@@ -23,6 +23,9 @@ bool getTargetUser(const rapidjson::Value &data, ActionUser &user);
 
 rapidjson::Document createListenMessage(const std::vector<std::string> &topicsVec,
                                         std::shared_ptr<providers::twitch::TwitchAccount> account);
+// An empty auth token creates an unauthenticated listen message
+rapidjson::Document createListenMessage(const std::vector<std::string> &topicsVec,
+                                        const QString &authToken);
 rapidjson::Document createUnlistenMessage(const std::vector<std::string> &topicsVec);
 
 // Create timer using given ioService
@@ -9,18 +9,93 @@
 #include "singletons/emotemanager.hpp"
 #include "singletons/ircmanager.hpp"
 #include "singletons/settingsmanager.hpp"
+#include "singletons/windowmanager.hpp"
 #include "util/posttothread.hpp"
+#include "util/tracing.hpp"
 #include "util/urlfetch.hpp"
+#include "widgets/split.hpp"
 
 #include <IrcConnection>
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace chatterino {
 namespace providers {
 namespace twitch {
 
-TwitchChannel::TwitchChannel(const QString &channelName, Communi::IrcConnection *_readConnection)
+namespace {
+
+// Parses the recent messages of the channels that are being opened. The pool is bounded so that
+// opening many channels at once doesn't take every core, channels in visible splits go first.
+QThreadPool &getRecentMessagesPool()
+{
+    static QThreadPool *pool = [] {
+        auto pool = new QThreadPool;
+        pool->setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount() - 1, 4)));
+        return pool;
+    }();
+
+    return *pool;
+}
+
+// how long building recent messages may block the gui thread at once
+const qint64 recentMessagesSliceMs = 5;
+
+struct RecentMessages {
+    std::vector<std::unique_ptr<Communi::IrcMessage>> parsed;
+    size_t next = 0;
+    std::vector<messages::MessagePtr> built;
+};
+
+// The builder reads the badge and cheermote tables and sets the room id of the channel, which
+// only the gui thread may touch. The parsed messages are built there in short slices, so opening
+// many channels at once doesn't block it.
+void buildRecentMessages(std::weak_ptr<Channel> weak, std::shared_ptr<RecentMessages> recent)
+{
+    ChannelPtr shared = weak.lock();
+
+    if (!shared) {
+        return;
+    }
+
+    auto channel = dynamic_cast<TwitchChannel *>(shared.get());
+    assert(channel != nullptr);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (recent->next < recent->parsed.size() && timer.elapsed() < recentMessagesSliceMs) {
+        util::tracing::Scope trace(util::tracing::Stage::MessageBuild);
+
+        auto privMsg =
+            static_cast<Communi::IrcPrivateMessage *>(recent->parsed[recent->next++].get());
+
+        messages::MessageParseArgs args;
+        twitch::TwitchMessageBuilder builder(channel, privMsg, args);
+        if (!builder.isIgnored()) {
+            recent->built.push_back(builder.build());
+        }
+    }
+
+    if (recent->next < recent->parsed.size()) {
+        // let the events that queued up meanwhile run before the next slice
+        util::postToThread([weak, recent] { buildRecentMessages(weak, recent); });
+        return;
+    }
+
+    shared->fillInMissingMessages(recent->built);
+}
+
+}  // namespace
+
+TwitchChannel::TwitchChannel(const QString &channelName)
     : Channel(channelName, Channel::Twitch)
     , bttvChannelEmotes(new util::EmoteMap)
     , ffzChannelEmotes(new util::EmoteMap)
@@ -28,7 +103,6 @@ TwitchChannel::TwitchChannel(const QString &channelName, Communi::IrcConnection
     , channelURL("https://twitch.tv/" + name)
     , popoutPlayerURL("https://player.twitch.tv/?channel=" + name)
     , mod(false)
-    , readConnection(_readConnection)
 {
     debug::Log("[TwitchChannel:{}] Opened", this->name);
 
@@ -111,6 +185,11 @@ TwitchChannel::~TwitchChannel()
 
     this->chattersListTimer->stop();
     this->chattersListTimer->deleteLater();
+
+    auto app = getApp();
+    if (!this->roomID.isEmpty() && app->twitch.server != nullptr) {
+        app->twitch.server->removeChannelRoomID(this->roomID);
+    }
 }
 
 bool TwitchChannel::isEmpty() const
@@ -125,9 +204,28 @@ bool TwitchChannel::canSendMessage() const
 
 void TwitchChannel::setRoomID(const QString &_roomID)
 {
+    bool changed = this->roomID != _roomID;
+    QString oldRoomID = this->roomID;
+
     this->roomID = _roomID;
+
+    if (changed) {
+        getApp()->twitch.server->updateChannelRoomID(
+            std::static_pointer_cast<TwitchChannel>(this->shared_from_this()), oldRoomID);
+    }
+
     this->roomIDchanged.invoke();
-    this->fetchMessages.invoke();
+
+    // room states are also sent when the room settings change, only fetch when it's needed
+    if (changed || this->messagesMissed) {
+        this->messagesMissed = false;
+        this->fetchMessages.invoke();
+    }
+}
+
+void TwitchChannel::markMessagesMissed()
+{
+    this->messagesMissed = true;
 }
 
 void TwitchChannel::reloadChannelEmotes()
@@ -320,30 +418,33 @@ void TwitchChannel::fetchRecentMessages()
             return;
         }
 
-        auto channel = dynamic_cast<TwitchChannel *>(shared.get());
-        assert(channel != nullptr);
-
-        static auto readConnection = channel->readConnection;
-
         QJsonArray msgArray = obj.value("messages").toArray();
         if (msgArray.empty()) {
             return;
         }
 
-        std::vector<messages::MessagePtr> messages;
+        bool isVisible = false;
+        getApp()->windows->forEachVisibleSplit([&](widgets::Split *split) {
+            isVisible |= split->getChannel() == shared;
+        });
+
+        // only the parsing runs on the pool, it doesn't touch any shared state
+        util::LambdaRunnable *task = new util::LambdaRunnable([weak, msgArray] {
+            auto recent = std::make_shared<RecentMessages>();
 
-        for (const QJsonValueRef _msg : msgArray) {
-            QByteArray content = _msg.toString().toUtf8();
-            auto msg = Communi::IrcMessage::fromData(content, readConnection);
-            auto privMsg = static_cast<Communi::IrcPrivateMessage *>(msg);
+            for (const QJsonValue &_msg : msgArray) {
+                QByteArray content = _msg.toString().toUtf8();
+                Communi::IrcMessage *msg = Communi::IrcMessage::fromData(content, nullptr);
 
-            messages::MessageParseArgs args;
-            twitch::TwitchMessageBuilder builder(channel, privMsg, args);
-            if (!builder.isIgnored()) {
-                messages.push_back(builder.build());
+                // the messages are built and deleted on the gui thread
+                msg->moveToThread(QCoreApplication::instance()->thread());
+                recent->parsed.emplace_back(msg);
             }
-        }
-        channel->addMessagesAtStart(messages);
+
+            util::postToThread([weak, recent] { buildRecentMessages(weak, recent); });
+        });
+
+        getRecentMessagesPool().start(task, isVisible ? 1 : 0);
     });
 }
 
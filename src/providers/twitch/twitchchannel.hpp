@@ -61,6 +61,9 @@ public:
     const QString popoutPlayerURL;
 
     void setRoomID(const QString &_roomID);
+    // The recent messages are fetched again with the next room state to fill in the messages that
+    // were missed, e.g. while the connection was lost
+    void markMessagesMissed();
     pajlada::Signals::NoArgSignal roomIDchanged;
     pajlada::Signals::NoArgSignal updateLiveInfo;
 
@@ -87,7 +90,7 @@ public:
     }
 
 private:
-    explicit TwitchChannel(const QString &channelName, Communi::IrcConnection *readConnection);
+    explicit TwitchChannel(const QString &channelName);
 
     void setLive(bool newLiveStatus);
     void refreshLiveStatus();
@@ -101,11 +104,10 @@ private:
     void fetchRecentMessages();
 
     bool mod;
+    bool messagesMissed = false;
     QByteArray messageSuffix;
     QString lastSentMessage;
 
-    Communi::IrcConnection *readConnection;
-
     friend class TwitchServer;
 
     // Key = login name
@@ -11,6 +11,7 @@
 #include "singletons/settingsmanager.hpp"
 #include "singletons/thememanager.hpp"
 #include "singletons/windowmanager.hpp"
+#include "util/tracing.hpp"
 
 #include <QApplication>
 #include <QDebug>
@@ -22,6 +23,29 @@ namespace chatterino {
 namespace providers {
 namespace twitch {
 
+namespace {
+
+// "key=value;key=value" with the escaping of irc tags
+QString serializeTags(const QVariantMap &tags)
+{
+    QStringList parts;
+
+    for (auto it = tags.begin(); it != tags.end(); ++it) {
+        QString value = it.value().toString();
+        value.replace("\\", "\\\\")
+            .replace(";", "\\:")
+            .replace(" ", "\\s")
+            .replace("\r", "\\r")
+            .replace("\n", "\\n");
+
+        parts.append(it.key() + "=" + value);
+    }
+
+    return parts.join(';');
+}
+
+}  // namespace
+
 TwitchMessageBuilder::TwitchMessageBuilder(Channel *_channel,
                                            const Communi::IrcPrivateMessage *_ircMessage,
                                            const messages::MessageParseArgs &_args)
@@ -78,6 +102,8 @@ bool TwitchMessageBuilder::isIgnored() const
 
 MessagePtr TwitchMessageBuilder::build()
 {
+    util::tracing::Scope trace(util::tracing::Stage::MessageBuild);
+
     auto app = getApp();
 
     // PARSING
@@ -98,12 +124,19 @@ MessagePtr TwitchMessageBuilder::build()
     this->appendChannelName();
 
     // timestamp
-    bool isPastMsg = this->tags.contains("historical");
-    if (isPastMsg) {
+    if (this->tags.contains("tmi-sent-ts")) {
         // This may be architecture dependent(datatype)
         qint64 ts = this->tags.value("tmi-sent-ts").toLongLong();
-        QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(ts);
-        this->emplace<TimestampElement>(dateTime.time());
+        this->message->serverReceivedTime = QDateTime::fromMSecsSinceEpoch(ts);
+    }
+
+    if (app->settings->enableLogging && app->settings->structuredLogs) {
+        this->message->ircTags = serializeTags(this->tags);
+    }
+
+    bool isPastMsg = this->tags.contains("historical");
+    if (isPastMsg) {
+        this->emplace<TimestampElement>(this->message->serverReceivedTime.time());
     } else {
         this->emplace<TimestampElement>();
     }
@@ -240,6 +273,7 @@ void TwitchMessageBuilder::parseMessageID()
 
     if (iterator != this->tags.end()) {
         this->messageID = iterator.value().toString();
+        this->message->id = this->messageID;
     }
 }
 
@@ -252,11 +286,8 @@ void TwitchMessageBuilder::parseRoomID()
     auto iterator = this->tags.find("room-id");
 
     if (iterator != std::end(this->tags)) {
+        // the channel only takes the room id of room states, see TwitchChannel::setRoomID
         this->roomID = iterator.value().toString();
-
-        if (this->twitchChannel->roomID.isEmpty()) {
-            this->twitchChannel->roomID = this->roomID;
-        }
     }
 }
 
@@ -377,6 +408,8 @@ void TwitchMessageBuilder::appendUsername()
 
 void TwitchMessageBuilder::parseHighlights()
 {
+    util::tracing::Scope trace(util::tracing::Stage::HighlightCheck);
+
     static auto player = new QMediaPlayer;
     static QUrl currentPlayerUrl;
 
@@ -538,14 +571,10 @@ bool TwitchMessageBuilder::tryAppendEmote(QString &emoteString)
     return false;
 }
 
-// fourtf: this is ugly
-//		   maybe put the individual badges into a map instead of this mess
 void TwitchMessageBuilder::appendTwitchBadges()
 {
     auto app = getApp();
 
-    const auto &channelResources = app->resources->channels[this->roomID];
-
     auto iterator = this->tags.find("badges");
 
     if (iterator == this->tags.end()) {
@@ -553,148 +582,23 @@ void TwitchMessageBuilder::appendTwitchBadges()
         return;
     }
 
+    const auto *channelResources = app->resources->findChannel(this->roomID);
+
     QStringList badges = iterator.value().toString().split(',');
 
-    for (QString badge : badges) {
+    for (const QString &badge : badges) {
         if (badge.isEmpty()) {
             continue;
         }
 
-        if (badge.startsWith("bits/")) {
-            if (!app->resources->dynamicBadgesLoaded) {
-                // Do nothing
-                continue;
-            }
-
-            QString cheerAmountQS = badge.mid(5);
-            std::string versionKey = cheerAmountQS.toStdString();
-
-            // Try to fetch channel-specific bit badge
-            try {
-                const auto &badge = channelResources.badgeSets.at("bits").versions.at(versionKey);
-                this->emplace<ImageElement>(badge.badgeImage1x, MessageElement::BadgeVanity);
-                continue;
-            } catch (const std::out_of_range &) {
-                // Channel does not contain a special bit badge for this version
-            }
-
-            // Use default bit badge
-            try {
-                const auto &badge = app->resources->badgeSets.at("bits").versions.at(versionKey);
-                this->emplace<ImageElement>(badge.badgeImage1x, MessageElement::BadgeVanity);
-            } catch (const std::out_of_range &) {
-                debug::Log("No default bit badge for version {} found", versionKey);
-                continue;
-            }
-        } else if (badge == "staff/1") {
-            this->emplace<ImageElement>(app->resources->badgeStaff,
-                                        MessageElement::BadgeGlobalAuthority)
-                ->setTooltip("Twitch Staff");
-        } else if (badge == "admin/1") {
-            this->emplace<ImageElement>(app->resources->badgeAdmin,
-                                        MessageElement::BadgeGlobalAuthority)
-                ->setTooltip("Twitch Admin");
-        } else if (badge == "global_mod/1") {
-            this->emplace<ImageElement>(app->resources->badgeGlobalModerator,
-                                        MessageElement::BadgeGlobalAuthority)
-                ->setTooltip("Twitch Global Moderator");
-        } else if (badge == "moderator/1") {
-            // TODO: Implement custom FFZ moderator badge
-            this->emplace<ImageElement>(app->resources->badgeModerator,
-                                        MessageElement::BadgeChannelAuthority)
-                ->setTooltip("Twitch Channel Moderator");
-        } else if (badge == "turbo/1") {
-            this->emplace<ImageElement>(app->resources->badgeTurbo,
-                                        MessageElement::BadgeGlobalAuthority)
-                ->setTooltip("Twitch Turbo Subscriber");
-        } else if (badge == "broadcaster/1") {
-            this->emplace<ImageElement>(app->resources->badgeBroadcaster,
-                                        MessageElement::BadgeChannelAuthority)
-                ->setTooltip("Twitch Broadcaster");
-        } else if (badge == "premium/1") {
-            this->emplace<ImageElement>(app->resources->badgePremium, MessageElement::BadgeVanity)
-                ->setTooltip("Twitch Prime Subscriber");
-        } else if (badge.startsWith("partner/")) {
-            int index = badge.midRef(8).toInt();
-            switch (index) {
-                case 1: {
-                    this->emplace<ImageElement>(app->resources->badgeVerified,
-                                                MessageElement::BadgeVanity)
-                        ->setTooltip("Twitch Verified");
-                } break;
-                default: {
-                    printf("[TwitchMessageBuilder] Unhandled partner badge index: %d\n", index);
-                } break;
-            }
-        } else if (badge.startsWith("subscriber/")) {
-            if (channelResources.loaded == false) {
-                // qDebug() << "Channel resources are not loaded, can't add the subscriber badge";
-                continue;
-            }
-
-            auto badgeSetIt = channelResources.badgeSets.find("subscriber");
-            if (badgeSetIt == channelResources.badgeSets.end()) {
-                // Fall back to default badge
-                this->emplace<ImageElement>(app->resources->badgeSubscriber,
-                                            MessageElement::BadgeSubscription)
-                    ->setTooltip("Twitch Subscriber");
-                continue;
-            }
-
-            const auto &badgeSet = badgeSetIt->second;
-
-            std::string versionKey = badge.mid(11).toStdString();
+        const auto *resolved = app->resources->resolveBadge(channelResources, badge);
 
-            auto badgeVersionIt = badgeSet.versions.find(versionKey);
-
-            if (badgeVersionIt == badgeSet.versions.end()) {
-                // Fall back to default badge
-                this->emplace<ImageElement>(app->resources->badgeSubscriber,
-                                            MessageElement::BadgeSubscription)
-                    ->setTooltip("Twitch Subscriber");
-                continue;
-            }
-
-            auto &badgeVersion = badgeVersionIt->second;
-
-            this->emplace<ImageElement>(badgeVersion.badgeImage1x,
-                                        MessageElement::BadgeSubscription)
-                ->setTooltip("Twitch " + QString::fromStdString(badgeVersion.title));
-        } else {
-            if (!app->resources->dynamicBadgesLoaded) {
-                // Do nothing
-                continue;
-            }
-
-            QStringList parts = badge.split('/');
-
-            if (parts.length() != 2) {
-                qDebug() << "Bad number of parts: " << parts.length() << " in " << parts;
-                continue;
-            }
-
-            MessageElement::Flags badgeType = MessageElement::Flags::BadgeVanity;
-
-            std::string badgeSetKey = parts[0].toStdString();
-            std::string versionKey = parts[1].toStdString();
-
-            try {
-                auto &badgeSet = app->resources->badgeSets.at(badgeSetKey);
-
-                try {
-                    auto &badgeVersion = badgeSet.versions.at(versionKey);
-
-                    this->emplace<ImageElement>(badgeVersion.badgeImage1x, badgeType)
-                        ->setTooltip("Twitch " + QString::fromStdString(badgeVersion.title));
-                } catch (const std::exception &e) {
-                    qDebug() << "Exception caught:" << e.what()
-                             << "when trying to fetch badge version " << versionKey.c_str();
-                }
-            } catch (const std::exception &e) {
-                qDebug() << "No badge set with key" << badgeSetKey.c_str()
-                         << ". Exception: " << e.what();
-            }
+        if (resolved == nullptr) {
+            continue;
         }
+
+        this->emplace<ImageElement>(resolved->image, resolved->type)
+            ->setTooltip(resolved->tooltip);
     }
 }
 
@@ -718,50 +622,22 @@ void TwitchMessageBuilder::appendChatterinoBadges()
 bool TwitchMessageBuilder::tryParseCheermote(const QString &string)
 {
     auto app = getApp();
-    // Try to parse custom cheermotes
-    const auto &channelResources = app->resources->channels[this->roomID];
-    if (channelResources.loaded) {
-        for (const auto &cheermoteSet : channelResources.cheermoteSets) {
-            auto match = cheermoteSet.regex.match(string);
-            if (!match.hasMatch()) {
-                continue;
-            }
-            QString amount = match.captured(1);
-            bool ok = false;
-            int numBits = amount.toInt(&ok);
-            if (!ok) {
-                debug::Log("Error parsing bit amount in tryParseCheermote");
-                return false;
-            }
-
-            auto savedIt = cheermoteSet.cheermotes.end();
-
-            // Fetch cheermote that matches our numBits
-            for (auto it = cheermoteSet.cheermotes.begin(); it != cheermoteSet.cheermotes.end();
-                 ++it) {
-                if (numBits >= it->minBits) {
-                    savedIt = it;
-                } else {
-                    break;
-                }
-            }
 
-            if (savedIt == cheermoteSet.cheermotes.end()) {
-                debug::Log("Error getting a cheermote from a cheermote set for the bit amount {}",
-                           numBits);
-                return false;
-            }
-
-            const auto &cheermote = *savedIt;
-
-            this->emplace<EmoteElement>(cheermote.emoteDataAnimated, EmoteElement::BitsAnimated);
-            this->emplace<TextElement>(amount, EmoteElement::Text, cheermote.color);
+    const auto *channelResources = app->resources->findChannel(this->roomID);
+    if (channelResources == nullptr) {
+        return false;
+    }
 
-            return true;
-        }
+    int numBits = 0;
+    const auto *cheermote = channelResources->matchCheermote(string, numBits);
+    if (cheermote == nullptr) {
+        return false;
     }
 
-    return false;
+    this->emplace<EmoteElement>(cheermote->emoteDataAnimated, EmoteElement::BitsAnimated);
+    this->emplace<TextElement>(QString::number(numBits), EmoteElement::Text, cheermote->color);
+
+    return true;
 }
 }  // namespace twitch
 }  // namespace providers
@@ -6,7 +6,12 @@
 #include "providers/twitch/twitchhelpers.hpp"
 #include "providers/twitch/twitchmessagebuilder.hpp"
 #include "singletons/accountmanager.hpp"
+#include "singletons/settingsmanager.hpp"
+#include "singletons/windowmanager.hpp"
 #include "util/posttothread.hpp"
+#include "widgets/split.hpp"
+
+#include <QElapsedTimer>
 
 #include <cassert>
 
@@ -66,7 +71,7 @@ void TwitchServer::initializeConnection(IrcConnection *connection, bool isRead,
 
 std::shared_ptr<Channel> TwitchServer::createChannel(const QString &channelName)
 {
-    TwitchChannel *channel = new TwitchChannel(channelName, this->getReadConnection());
+    TwitchChannel *channel = new TwitchChannel(channelName);
 
     channel->sendMessageSignal.connect(
         [this](auto chan, auto msg) { this->sendMessage(chan, msg); });
@@ -74,6 +79,89 @@ std::shared_ptr<Channel> TwitchServer::createChannel(const QString &channelName)
     return std::shared_ptr<Channel>(channel);
 }
 
+bool TwitchServer::isMessageHandled(IrcMessage *message, bool isPrimaryConnection)
+{
+    // keep in sync with messageReceived, this mostly drops the JOIN and PART messages of the
+    // membership capability before they reach the gui thread
+    static const QStringList handledCommands = {
+        "ROOMSTATE", "CLEARCHAT", "USERSTATE", "WHISPER", "USERNOTICE", "MODE", "NOTICE",
+    };
+
+    if (message->type() == IrcMessage::Type::Private) {
+        return true;
+    }
+
+    // whispers are received on every read connection
+    if (message->command() == "WHISPER") {
+        return isPrimaryConnection;
+    }
+
+    return handledCommands.contains(message->command());
+}
+
+int TwitchServer::getMaxReadConnections()
+{
+    return getApp()->settings->maxReadConnections.getValue();
+}
+
+int TwitchServer::getChannelsPerReadConnection()
+{
+    return getApp()->settings->channelsPerReadConnection.getValue();
+}
+
+QSet<QString> TwitchServer::getPrioritizedChannels()
+{
+    QSet<QString> channelNames;
+
+    // channels in visible splits are joined first
+    getApp()->windows->forEachVisibleSplit([&channelNames](widgets::Split *split) {
+        channelNames.insert(split->getChannel()->name);
+    });
+
+    return channelNames;
+}
+
+bool TwitchServer::hasElevatedRights(const QString &channelName)
+{
+    auto twitchChannel =
+        std::dynamic_pointer_cast<TwitchChannel>(this->getChannelOrEmpty(channelName));
+
+    return twitchChannel && twitchChannel->hasModRights();
+}
+
+bool TwitchServer::isModerationMessage(const QString &message)
+{
+    static const QStringList moderationCommands = {
+        "ban",         "unban",         "timeout",   "untimeout",    "delete",  "clear",
+        "slow",        "slowoff",       "followers", "followersoff", "r9kbeta", "r9kbetaoff",
+        "subscribers", "subscribersoff", "emoteonly", "emoteonlyoff",
+    };
+
+    // twitch accepts commands starting with either '/' or '.'
+    if (!message.startsWith('/') && !message.startsWith('.')) {
+        return false;
+    }
+
+    return moderationCommands.contains(message.section(' ', 0, 0).mid(1), Qt::CaseInsensitive);
+}
+
+void TwitchServer::onDisconnected(const QStringList &channelNames)
+{
+    AbstractIrcServer::onDisconnected(channelNames);
+
+    std::lock_guard<std::mutex> lock(this->channelMutex);
+
+    // the messages sent while disconnected are fetched once the channels are joined again
+    for (const QString &channelName : channelNames) {
+        auto channel =
+            std::dynamic_pointer_cast<TwitchChannel>(this->channels.value(channelName).lock());
+
+        if (channel) {
+            channel->markMessagesMissed();
+        }
+    }
+}
+
 void TwitchServer::privateMessageReceived(IrcPrivateMessage *message)
 {
     QString channelName;
@@ -93,8 +181,16 @@ void TwitchServer::privateMessageReceived(IrcPrivateMessage *message)
     TwitchMessageBuilder builder(chan.get(), message, args);
 
     if (!builder.isIgnored()) {
+        QElapsedTimer buildTimer;
+        buildTimer.start();
+
         messages::MessagePtr _message = builder.build();
-        if (_message->flags & messages::Message::Highlighted) {
+        bool highlighted = _message->flags & messages::Message::Highlighted;
+
+        chan->statistics.addMessage(message->toData().size(), buildTimer.nsecsElapsed(),
+                                    highlighted);
+
+        if (highlighted) {
             this->mentionsChannel->addMessage(_message);
         }
 
@@ -173,28 +269,43 @@ void TwitchServer::forEachChannelAndSpecialChannels(std::function<void(ChannelPt
 std::shared_ptr<Channel> TwitchServer::getChannelOrEmptyByID(const QString &channelID)
 {
     {
-        std::lock_guard<std::mutex> lock(this->channelMutex);
-
-        for (const auto &weakChannel : this->channels) {
-            auto channel = weakChannel.lock();
-            if (!channel) {
-                continue;
-            }
-
-            auto twitchChannel = std::dynamic_pointer_cast<TwitchChannel>(channel);
-            if (!twitchChannel) {
-                continue;
-            }
-
-            if (twitchChannel->roomID == channelID) {
-                return twitchChannel;
-            }
+        QReadLocker lock(&this->channelsByRoomIDLock);
+
+        auto twitchChannel = this->channelsByRoomID.value(channelID).lock();
+
+        if (twitchChannel) {
+            return twitchChannel;
         }
     }
 
     return Channel::getEmpty();
 }
 
+void TwitchServer::updateChannelRoomID(const std::shared_ptr<TwitchChannel> &channel,
+                                       const QString &oldRoomID)
+{
+    QWriteLocker lock(&this->channelsByRoomIDLock);
+
+    if (!oldRoomID.isEmpty() && this->channelsByRoomID.value(oldRoomID).lock() == channel) {
+        this->channelsByRoomID.remove(oldRoomID);
+    }
+
+    if (!channel->roomID.isEmpty()) {
+        this->channelsByRoomID.insert(channel->roomID, channel);
+    }
+}
+
+void TwitchServer::removeChannelRoomID(const QString &roomID)
+{
+    QWriteLocker lock(&this->channelsByRoomIDLock);
+
+    // the entry may already belong to another channel with the same room id
+    auto it = this->channelsByRoomID.find(roomID);
+    if (it != this->channelsByRoomID.end() && it.value().expired()) {
+        this->channelsByRoomID.erase(it);
+    }
+}
+
 QString TwitchServer::cleanChannelName(const QString &dirtyChannelName)
 {
     return dirtyChannelName.toLower();
@@ -4,6 +4,9 @@
 #include "providers/twitch/twitchaccount.hpp"
 #include "providers/twitch/twitchchannel.hpp"
 
+#include <QHash>
+#include <QReadWriteLock>
+
 #include <memory>
 
 namespace chatterino {
@@ -22,6 +25,12 @@ public:
 
     std::shared_ptr<Channel> getChannelOrEmptyByID(const QString &channelID);
 
+    // Keep the room id index up to date, called by TwitchChannel when its room id changes and when
+    // it is destroyed
+    void updateChannelRoomID(const std::shared_ptr<TwitchChannel> &channel,
+                             const QString &oldRoomID);
+    void removeChannelRoomID(const QString &roomID);
+
     const ChannelPtr whispersChannel;
     const ChannelPtr mentionsChannel;
     IndirectChannel watchingChannel;
@@ -31,6 +40,16 @@ protected:
                               bool isWrite) override;
     std::shared_ptr<Channel> createChannel(const QString &channelName) override;
 
+    bool isMessageHandled(Communi::IrcMessage *message, bool isPrimaryConnection) override;
+
+    int getMaxReadConnections() override;
+    int getChannelsPerReadConnection() override;
+    QSet<QString> getPrioritizedChannels() override;
+    bool hasElevatedRights(const QString &channelName) override;
+    bool isModerationMessage(const QString &message) override;
+
+    void onDisconnected(const QStringList &channelNames) override;
+
     void privateMessageReceived(Communi::IrcPrivateMessage *message) override;
     void messageReceived(Communi::IrcMessage *message) override;
     void writeConnectionMessageReceived(Communi::IrcMessage *message) override;
@@ -38,6 +57,12 @@ protected:
     std::shared_ptr<Channel> getCustomChannel(const QString &channelname) override;
 
     QString cleanChannelName(const QString &dirtyChannelName) override;
+
+private:
+    // Twitch channels by room id. It has its own lock so lookups don't wait for joins and parts,
+    // which hold channelMutex.
+    QHash<QString, std::weak_ptr<TwitchChannel>> channelsByRoomID;
+    QReadWriteLock channelsByRoomIDLock;
 };
 
 }  // namespace twitch
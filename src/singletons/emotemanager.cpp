@@ -2,6 +2,7 @@
 
 #include "application.hpp"
 #include "common.hpp"
+#include "singletons/resourcemanager.hpp"
 #include "singletons/settingsmanager.hpp"
 #include "singletons/windowmanager.hpp"
 #include "util/urlfetch.hpp"
@@ -93,6 +94,8 @@ void EmoteManager::initialize()
     });
 
     this->loadEmojis();
+    this->incCompletionGeneration();
+
     this->loadBTTVEmotes();
     this->loadFFZEmotes();
 }
@@ -455,6 +458,7 @@ void EmoteManager::refreshTwitchEmotes(const std::shared_ptr<TwitchAccount> &use
             }
 
             emoteData.filled = true;
+            this->incCompletionGeneration();
         });
 }
 
@@ -489,6 +493,7 @@ void EmoteManager::loadBTTVEmotes()
         }
 
         this->bttvGlobalEmoteCodes = codes;
+        this->incCompletionGeneration();
     });
 }
 
@@ -521,6 +526,8 @@ void EmoteManager::loadFFZEmotes()
 
             this->ffzGlobalEmoteCodes = codes;
         }
+
+        this->incCompletionGeneration();
     });
 }
 
@@ -546,8 +553,15 @@ util::EmoteData EmoteManager::getTwitchEmoteById(long id, const QString &emoteNa
 
 util::EmoteData EmoteManager::getCheerImage(long long amount, bool animated)
 {
-    // TODO: fix this xD
-    return util::EmoteData();
+    auto app = getApp();
+
+    const auto *cheermote = app->resources->defaultCheermoteSet.getCheermote(amount);
+
+    if (cheermote == nullptr) {
+        return util::EmoteData();
+    }
+
+    return animated ? cheermote->emoteDataAnimated : cheermote->emoteDataStatic;
 }
 
 pajlada::Signals::NoArgSignal &EmoteManager::getGifUpdateSignal()
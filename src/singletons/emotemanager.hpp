@@ -17,6 +17,8 @@
 #include <QTimer>
 #include <pajlada/signals/signal.hpp>
 
+#include <atomic>
+
 namespace chatterino {
 namespace singletons {
 
@@ -56,6 +58,18 @@ public:
         _generation++;
     }
 
+    // Changes when the emote codes every channel can complete change, the shared completion
+    // index is only rebuilt then
+    int getCompletionGeneration() const
+    {
+        return this->completionGeneration;
+    }
+
+    void incCompletionGeneration()
+    {
+        this->completionGeneration++;
+    }
+
     pajlada::Signals::NoArgSignal &getGifUpdateSignal();
 
     // Bit badge/emotes?
@@ -147,6 +161,7 @@ private:
     bool gifUpdateTimerInitiated = false;
 
     int _generation = 0;
+    std::atomic<int> completionGeneration{0};
 };
 
 }  // namespace singletons
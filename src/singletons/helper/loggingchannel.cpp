@@ -1,70 +1,137 @@
 #include "loggingchannel.hpp"
 
+#include "singletons/helper/logwriter.hpp"
+
 #include <QDir>
 
 #include <ctime>
 
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace chatterino {
 namespace singletons {
 
 QByteArray endline("\n");
 
-LoggingChannel::LoggingChannel(const QString &_channelName, const QString &_baseDirectory)
+LoggingChannel::LoggingChannel(const QString &_channelName, const QString &_baseDirectory,
+                               LogWriter &_writer)
     : channelName(_channelName)
     , baseDirectory(_baseDirectory)
+    , writer(_writer)
 {
-    QDateTime now = QDateTime::currentDateTime();
+}
+
+void LoggingChannel::addMessage(std::shared_ptr<messages::Message> message)
+{
+    this->writer.push(this, std::move(message));
+}
 
-    this->dateString = this->generateDateString(now);
+void LoggingChannel::detachFromWriter()
+{
+    this->writer.remove(this);
+}
 
-    this->openLogFile();
+QString LoggingChannel::getFilePath(const QString &dateString, const QString &extension) const
+{
+    QString baseFileName = this->channelName + "-" + dateString + extension;
 
-    this->appendLine(this->generateOpeningString(now));
+    return this->baseDirectory + QDir::separator() + baseFileName;
 }
 
-LoggingChannel::~LoggingChannel()
+QString LoggingChannel::generateDateString(const QDateTime &now)
 {
+    return now.toString("yyyy-MM-dd");
+}
+
+LogBatch LoggingChannel::createBatch(bool sync)
+{
+    LogBatch batch;
+    batch.time = QDateTime::currentDateTime();
+    batch.dateString = generateDateString(batch.time);
+    batch.sync = sync;
+
+    return batch;
+}
+
+void LoggingChannel::syncFile(QFile &file)
+{
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    fsync(file.handle());
+#endif
+}
+
+TextLoggingChannel::TextLoggingChannel(const QString &_channelName,
+                                       const QString &_baseDirectory, LogWriter &_writer)
+    : LoggingChannel(_channelName, _baseDirectory, _writer)
+{
+    // the file is opened by the writer with the first batch
+    this->appendLine(this->generateOpeningString());
+}
+
+TextLoggingChannel::~TextLoggingChannel()
+{
+    this->detachFromWriter();
+
     this->appendLine(this->generateClosingString());
+    this->writePending(createBatch(false), true);
     this->fileHandle.close();
 }
 
-void LoggingChannel::openLogFile()
+void TextLoggingChannel::openLogFile()
 {
     if (this->fileHandle.isOpen()) {
         this->fileHandle.flush();
         this->fileHandle.close();
     }
 
-    QString baseFileName = this->channelName + "-" + this->dateString + ".log";
-
     // Open file handle to log file of current date
-    this->fileHandle.setFileName(this->baseDirectory + QDir::separator() + baseFileName);
+    this->fileHandle.setFileName(this->getFilePath(this->dateString, ".log"));
 
     this->fileHandle.open(QIODevice::Append);
 }
 
-void LoggingChannel::addMessage(std::shared_ptr<messages::Message> message)
+void TextLoggingChannel::appendMessage(const messages::Message &message)
 {
-    QDateTime now = QDateTime::currentDateTime();
-
-    QString messageDateString = this->generateDateString(now);
-    if (messageDateString != this->dateString) {
-        this->dateString = messageDateString;
-        this->openLogFile();
-    }
-
     QString str;
     str.append('[');
-    str.append(now.toString("HH:mm:ss"));
+    str.append(message.serverReceivedTime.toString("HH:mm:ss"));
     str.append("] ");
 
-    str.append(message->searchText);
+    str.append(message.searchText);
     str.append(endline);
 
     this->appendLine(str);
 }
 
-QString LoggingChannel::generateOpeningString(const QDateTime &now) const
+bool TextLoggingChannel::writePending(const LogBatch &batch, bool)
+{
+    if (batch.dateString != this->dateString || !this->fileHandle.isOpen()) {
+        this->dateString = batch.dateString;
+        this->openLogFile();
+    }
+
+    if (this->pending.isEmpty()) {
+        return false;
+    }
+
+    this->fileHandle.write(this->pending);
+    this->fileHandle.flush();
+    this->pending.clear();
+
+    if (batch.sync) {
+        syncFile(this->fileHandle);
+    }
+
+    return false;
+}
+
+QString TextLoggingChannel::generateOpeningString(const QDateTime &now) const
 {
     QString ret = QLatin1Literal("# Start logging at ");
 
@@ -75,7 +142,7 @@ QString LoggingChannel::generateOpeningString(const QDateTime &now) const
     return ret;
 }
 
-QString LoggingChannel::generateClosingString(const QDateTime &now) const
+QString TextLoggingChannel::generateClosingString(const QDateTime &now) const
 {
     QString ret = QLatin1Literal("# Stop logging at ");
 
@@ -86,27 +153,9 @@ QString LoggingChannel::generateClosingString(const QDateTime &now) const
     return ret;
 }
 
-void LoggingChannel::appendLine(const QString &line)
+void TextLoggingChannel::appendLine(const QString &line)
 {
-    /*
-    auto a1 = line.toUtf8();
-    auto a2 = line.toLatin1();
-    auto a3 = line.toLocal8Bit();
-
-    auto a4 = line.data();
-
-    auto a5 = line.toStdString();
-    */
-
-    // this->fileHandle.write(a5.c_str(), a5.length());
-    // this->fileHandle.write(a5.c_str(), a5.length());
-    this->fileHandle.write(line.toUtf8());
-    this->fileHandle.flush();
-}
-
-QString LoggingChannel::generateDateString(const QDateTime &now)
-{
-    return now.toString("yyyy-MM-dd");
+    this->pending.append(line.toUtf8());
 }
 
 }  // namespace singletons
@@ -2,6 +2,7 @@
 
 #include "messages/message.hpp"
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QFile>
 #include <QString>
@@ -12,14 +13,64 @@
 namespace chatterino {
 namespace singletons {
 
+class LogWriter;
+
+// What a batch of the writer was written at, the time is only checked once per batch
+struct LogBatch {
+    QDateTime time;
+    QString dateString;
+    bool sync = false;
+};
+
+// The log of one channel. Messages are added on the gui thread, everything else happens on the
+// thread of the writer.
 class LoggingChannel : boost::noncopyable
 {
-    explicit LoggingChannel(const QString &_channelName, const QString &_baseDirectory);
-
 public:
-    ~LoggingChannel();
+    virtual ~LoggingChannel() = default;
+
     void addMessage(std::shared_ptr<messages::Message> message);
 
+protected:
+    LoggingChannel(const QString &_channelName, const QString &_baseDirectory,
+                   LogWriter &_writer);
+
+    virtual void appendMessage(const messages::Message &message) = 0;
+
+    // Writes what was appended, returns true if some of it was kept for a later batch. force
+    // writes everything.
+    virtual bool writePending(const LogBatch &batch, bool force) = 0;
+
+    // Has to be called first by the destructor of a subclass, the writer doesn't use the channel
+    // once it returns
+    void detachFromWriter();
+
+    QString getFilePath(const QString &dateString, const QString &extension) const;
+
+    static QString generateDateString(const QDateTime &now);
+    static LogBatch createBatch(bool sync);
+    static void syncFile(QFile &file);
+
+    const QString channelName;
+    const QString baseDirectory;
+    LogWriter &writer;
+
+    friend class LogWriter;
+};
+
+// "[HH:mm:ss] text" lines in one file per day
+class TextLoggingChannel : public LoggingChannel
+{
+    explicit TextLoggingChannel(const QString &_channelName, const QString &_baseDirectory,
+                                LogWriter &_writer);
+
+public:
+    ~TextLoggingChannel() override;
+
+protected:
+    void appendMessage(const messages::Message &message) override;
+    bool writePending(const LogBatch &batch, bool force) override;
+
 private:
     void openLogFile();
 
@@ -28,15 +79,13 @@ private:
 
     void appendLine(const QString &line);
 
-    QString generateDateString(const QDateTime &now);
-
-    const QString channelName;
-    const QString baseDirectory;
-
     QFile fileHandle;
 
     QString dateString;
 
+    // lines that weren't written to the file yet
+    QByteArray pending;
+
     friend class LoggingManager;
 };
 
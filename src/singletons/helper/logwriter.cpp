@@ -0,0 +1,144 @@
+#include "singletons/helper/logwriter.hpp"
+
+#include "singletons/helper/loggingchannel.hpp"
+#include "util/assertinguithread.hpp"
+
+#include <QSet>
+
+#include <algorithm>
+#include <chrono>
+
+namespace chatterino {
+namespace singletons {
+
+LogWriter::LogWriter()
+    : thread([this] { this->run(); })
+{
+}
+
+LogWriter::~LogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->wakeCondition.notify_all();
+    this->thread.join();
+}
+
+void LogWriter::push(LoggingChannel *channel, messages::MessagePtr message)
+{
+    // the queue has a single producer
+    util::assertInGuiThread();
+
+    this->queue.push(Entry{Entry::Message, channel, std::move(message)});
+}
+
+void LogWriter::flush()
+{
+    util::assertInGuiThread();
+
+    this->queue.push(Entry{Entry::Flush, nullptr, nullptr});
+
+    this->waitForBatch();
+}
+
+void LogWriter::remove(LoggingChannel *channel)
+{
+    util::assertInGuiThread();
+
+    this->queue.push(Entry{Entry::Remove, channel, nullptr});
+
+    this->waitForBatch();
+}
+
+void LogWriter::setFlushInterval(int milliseconds)
+{
+    this->flushInterval = std::max(10, milliseconds);
+}
+
+void LogWriter::setSyncAfterWrite(bool sync)
+{
+    this->syncAfterWrite = sync;
+}
+
+void LogWriter::waitForBatch()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    uint64_t request = ++this->batchRequests;
+    this->wakeCondition.notify_all();
+
+    this->finishedCondition.wait(lock, [&] { return this->finishedRequests >= request; });
+}
+
+void LogWriter::run()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (!this->stopping) {
+        this->wakeCondition.wait_for(lock, std::chrono::milliseconds(this->flushInterval.load()),
+                                     [this] {
+                                         return this->stopping ||
+                                                this->batchRequests > this->finishedRequests;
+                                     });
+
+        uint64_t requests = this->batchRequests;
+
+        lock.unlock();
+        this->writeBatch();
+        lock.lock();
+
+        this->finishedRequests = requests;
+        this->finishedCondition.notify_all();
+    }
+}
+
+void LogWriter::writeBatch()
+{
+    Entry entry;
+    QSet<LoggingChannel *> channels;
+    bool force = false;
+
+    while (this->queue.pop(entry)) {
+        switch (entry.kind) {
+            case Entry::Message: {
+                entry.channel->appendMessage(*entry.message);
+                channels.insert(entry.channel);
+            } break;
+
+            case Entry::Flush: {
+                force = true;
+            } break;
+
+            case Entry::Remove: {
+                // the channel writes the rest itself
+                channels.remove(entry.channel);
+                this->waitingChannels.erase(entry.channel);
+            } break;
+        }
+    }
+
+    for (LoggingChannel *channel : this->waitingChannels) {
+        channels.insert(channel);
+    }
+
+    if (channels.isEmpty()) {
+        return;
+    }
+
+    // the date is only checked once per batch, a batch that spans midnight goes into the new file
+    LogBatch batch = LoggingChannel::createBatch(this->syncAfterWrite);
+
+    for (LoggingChannel *channel : channels) {
+        if (channel->writePending(batch, force)) {
+            this->waitingChannels.insert(channel);
+        } else {
+            this->waitingChannels.erase(channel);
+        }
+    }
+}
+
+}  // namespace singletons
+}  // namespace chatterino
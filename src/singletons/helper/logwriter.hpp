@@ -0,0 +1,78 @@
+#pragma once
+
+#include "messages/message.hpp"
+#include "util/spscqueue.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace chatterino {
+namespace singletons {
+
+class LoggingChannel;
+
+// Writes the logs on its own thread. The gui thread pushes messages into a lock-free queue, the
+// writer takes everything that was queued once per flush interval and writes it with one write
+// per log file.
+class LogWriter : boost::noncopyable
+{
+public:
+    LogWriter();
+    ~LogWriter();
+
+    // push, flush and remove are gui thread only, the queue only supports a single producer
+    void push(LoggingChannel *channel, messages::MessagePtr message);
+
+    // Blocks until everything that was pushed before is written. Channels that keep lines for
+    // later batches write them as well.
+    void flush();
+
+    // Blocks until the writer doesn't use the channel anymore, what it didn't write yet stays in
+    // the channel
+    void remove(LoggingChannel *channel);
+
+    void setFlushInterval(int milliseconds);
+    void setSyncAfterWrite(bool sync);
+
+private:
+    struct Entry {
+        enum Kind { Message, Flush, Remove };
+
+        Kind kind = Message;
+        LoggingChannel *channel = nullptr;
+        messages::MessagePtr message;
+    };
+
+    void run();
+    void writeBatch();
+
+    // Blocks until the writer took everything that is queued
+    void waitForBatch();
+
+    util::SpscQueue<Entry> queue;
+
+    // writer thread only, channels that kept lines for a later batch
+    std::unordered_set<LoggingChannel *> waitingChannels;
+
+    std::atomic<int> flushInterval{1000};
+    std::atomic<bool> syncAfterWrite{false};
+
+    // only used to sleep between batches and to wait for them, the queue doesn't lock
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable finishedCondition;
+    uint64_t batchRequests = 0;
+    uint64_t finishedRequests = 0;
+    bool stopping = false;
+
+    std::thread thread;
+};
+
+}  // namespace singletons
+}  // namespace chatterino
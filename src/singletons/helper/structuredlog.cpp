@@ -0,0 +1,252 @@
+#include "singletons/helper/structuredlog.hpp"
+
+#include <QDataStream>
+#include <QSet>
+
+#include <algorithm>
+
+namespace chatterino {
+namespace singletons {
+namespace structuredlog {
+
+namespace {
+
+const quint32 blockMagic = 0x434c4f47;  // "CLOG"
+
+// zstd and lz4 aren't dependencies, blocks are compressed with zlib through qCompress. The header
+// keeps the compression so other ones can be added later.
+const quint8 compressionZlib = 1;
+
+void setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_5_0);
+}
+
+QByteArray encodeRecord(const Record &record)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    setupStream(stream);
+
+    stream << record.timestamp << record.flags << record.channelName << record.loginName
+           << record.displayName << record.messageID << record.text << record.ircTags;
+
+    return bytes;
+}
+
+bool decodeRecord(const QByteArray &bytes, Record &record)
+{
+    QDataStream stream(bytes);
+    setupStream(stream);
+
+    stream >> record.timestamp >> record.flags >> record.channelName >> record.loginName >>
+        record.displayName >> record.messageID >> record.text >> record.ircTags;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+// Reads the header of the block at the position of the file and moves behind the block
+bool readBlockHeader(QFile &logFile, BlockInfo &block, quint32 &payloadSize)
+{
+    block.offset = logFile.pos();
+
+    QDataStream stream(&logFile);
+    setupStream(stream);
+
+    quint32 magic;
+    quint8 compression;
+
+    stream >> magic >> compression >> block.recordCount >> block.firstTimestamp >>
+        block.lastTimestamp >> block.users >> payloadSize;
+
+    if (stream.status() != QDataStream::Ok || magic != blockMagic ||
+        compression != compressionZlib) {
+        return false;
+    }
+
+    return logFile.seek(logFile.pos() + payloadSize);
+}
+
+void writeIndexEntry(QDataStream &stream, const BlockInfo &block)
+{
+    stream << block.offset << block.firstTimestamp << block.lastTimestamp << block.recordCount
+           << block.users;
+}
+
+}  // namespace
+
+bool BlockInfo::mayContainUser(const QString &loginName) const
+{
+    return std::binary_search(this->users.begin(), this->users.end(), loginName.toLower());
+}
+
+bool BlockInfo::overlaps(qint64 from, qint64 to) const
+{
+    return this->firstTimestamp <= to && this->lastTimestamp >= from;
+}
+
+QString getIndexPath(const QString &logPath)
+{
+    return logPath + ".idx";
+}
+
+bool appendBlock(QFile &logFile, QFile &indexFile, const std::vector<Record> &records)
+{
+    if (records.empty()) {
+        return true;
+    }
+
+    BlockInfo block;
+    block.offset = logFile.size();
+    block.firstTimestamp = records.front().timestamp;
+    block.lastTimestamp = records.front().timestamp;
+    block.recordCount = quint32(records.size());
+
+    QByteArray payload;
+    QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+    setupStream(payloadStream);
+
+    QSet<QString> users;
+
+    for (const Record &record : records) {
+        payloadStream << encodeRecord(record);
+
+        block.firstTimestamp = std::min(block.firstTimestamp, record.timestamp);
+        block.lastTimestamp = std::max(block.lastTimestamp, record.timestamp);
+
+        if (!record.loginName.isEmpty()) {
+            users.insert(record.loginName.toLower());
+        }
+    }
+
+    block.users = users.toList();
+    std::sort(block.users.begin(), block.users.end());
+
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    setupStream(stream);
+
+    stream << blockMagic << compressionZlib << block.recordCount << block.firstTimestamp
+           << block.lastTimestamp << block.users << qCompress(payload);
+
+    if (logFile.write(bytes) != bytes.size()) {
+        return false;
+    }
+
+    QByteArray indexBytes;
+    QDataStream indexStream(&indexBytes, QIODevice::WriteOnly);
+    setupStream(indexStream);
+    writeIndexEntry(indexStream, block);
+
+    // a missing index entry is restored from the block header when the index is read
+    indexFile.write(indexBytes);
+
+    return true;
+}
+
+std::vector<BlockInfo> readIndex(const QString &logPath)
+{
+    std::vector<BlockInfo> blocks;
+
+    QFile logFile(logPath);
+    if (!logFile.open(QIODevice::ReadOnly)) {
+        return blocks;
+    }
+
+    QFile indexFile(getIndexPath(logPath));
+    if (indexFile.open(QIODevice::ReadOnly)) {
+        QDataStream stream(&indexFile);
+        setupStream(stream);
+
+        while (!stream.atEnd()) {
+            BlockInfo block;
+            stream >> block.offset >> block.firstTimestamp >> block.lastTimestamp >>
+                block.recordCount >> block.users;
+
+            if (stream.status() != QDataStream::Ok) {
+                break;
+            }
+
+            blocks.push_back(block);
+        }
+    }
+
+    // continue behind the last indexed block, blocks written after it aren't indexed
+    qint64 position = 0;
+
+    while (!blocks.empty()) {
+        BlockInfo block;
+        quint32 payloadSize;
+
+        if (logFile.seek(blocks.back().offset) &&
+            readBlockHeader(logFile, block, payloadSize)) {
+            position = logFile.pos();
+            break;
+        }
+
+        blocks.pop_back();
+    }
+
+    logFile.seek(position);
+
+    while (!logFile.atEnd()) {
+        BlockInfo block;
+        quint32 payloadSize;
+
+        if (!readBlockHeader(logFile, block, payloadSize)) {
+            break;
+        }
+
+        blocks.push_back(block);
+    }
+
+    return blocks;
+}
+
+bool readBlock(QFile &logFile, const BlockInfo &block, std::vector<Record> &records)
+{
+    if (!logFile.seek(block.offset)) {
+        return false;
+    }
+
+    QDataStream stream(&logFile);
+    setupStream(stream);
+
+    BlockInfo header;
+    quint32 magic;
+    quint8 compression;
+    QByteArray compressed;
+
+    stream >> magic >> compression >> header.recordCount >> header.firstTimestamp >>
+        header.lastTimestamp >> header.users >> compressed;
+
+    if (stream.status() != QDataStream::Ok || magic != blockMagic ||
+        compression != compressionZlib) {
+        return false;
+    }
+
+    QByteArray payload = qUncompress(compressed);
+
+    QDataStream payloadStream(payload);
+    setupStream(payloadStream);
+
+    records.reserve(records.size() + header.recordCount);
+
+    while (!payloadStream.atEnd()) {
+        QByteArray bytes;
+        payloadStream >> bytes;
+
+        Record record;
+        if (payloadStream.status() != QDataStream::Ok || !decodeRecord(bytes, record)) {
+            return false;
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    return true;
+}
+
+}  // namespace structuredlog
+}  // namespace singletons
+}  // namespace chatterino
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+namespace singletons {
+namespace structuredlog {
+
+// Structured logs are a sequence of blocks. Every block has an uncompressed header with its time
+// range and users, followed by the compressed records. The records in a block are length prefixed.
+// A sparse index with one entry per block is kept next to the log in "<log>.idx", it can be rebuilt
+// from the block headers.
+//
+// Only depends on QtCore, the logtool reads the logs with it as well.
+
+struct Record {
+    // milliseconds since the epoch
+    qint64 timestamp = 0;
+    quint32 flags = 0;
+
+    QString channelName;
+    QString loginName;
+    QString displayName;
+    QString messageID;
+    QString text;
+
+    // raw irc tags, "key=value;key=value"
+    QString ircTags;
+};
+
+struct BlockInfo {
+    // position of the block header in the log file
+    qint64 offset = 0;
+
+    qint64 firstTimestamp = 0;
+    qint64 lastTimestamp = 0;
+    quint32 recordCount = 0;
+
+    // distinct login names of the block, sorted
+    QStringList users;
+
+    bool mayContainUser(const QString &loginName) const;
+    bool overlaps(qint64 from, qint64 to) const;
+};
+
+QString getIndexPath(const QString &logPath);
+
+// Appends the records as one block to the log file and its entry to the index file
+bool appendBlock(QFile &logFile, QFile &indexFile, const std::vector<Record> &records);
+
+// Reads the index of a log file. If it's missing or out of date it's rebuilt from the block
+// headers of the log file.
+std::vector<BlockInfo> readIndex(const QString &logPath);
+
+bool readBlock(QFile &logFile, const BlockInfo &block, std::vector<Record> &records);
+
+}  // namespace structuredlog
+}  // namespace singletons
+}  // namespace chatterino
@@ -0,0 +1,124 @@
+#include "singletons/helper/structuredloggingchannel.hpp"
+
+#include "singletons/helper/logwriter.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace chatterino {
+namespace singletons {
+
+namespace {
+
+// a block is written once it has this many records, or its oldest record waited this long
+const size_t recordsPerBlock = 512;
+const qint64 maxBlockAge = 60 * 1000;
+
+}  // namespace
+
+StructuredLoggingChannel::StructuredLoggingChannel(const QString &_channelName,
+                                                   const QString &_baseDirectory,
+                                                   LogWriter &_writer)
+    : LoggingChannel(_channelName, _baseDirectory, _writer)
+{
+}
+
+StructuredLoggingChannel::~StructuredLoggingChannel()
+{
+    this->detachFromWriter();
+
+    this->writePending(createBatch(false), true);
+    this->fileHandle.close();
+    this->indexHandle.close();
+}
+
+void StructuredLoggingChannel::openLogFile()
+{
+    if (this->fileHandle.isOpen()) {
+        this->fileHandle.close();
+        this->indexHandle.close();
+    }
+
+    this->fileHandle.setFileName(this->getFilePath(this->dateString, ".clog"));
+    this->fileHandle.open(QIODevice::Append);
+
+    this->indexHandle.setFileName(structuredlog::getIndexPath(this->fileHandle.fileName()));
+    this->indexHandle.open(QIODevice::Append);
+}
+
+void StructuredLoggingChannel::appendMessage(const messages::Message &message)
+{
+    structuredlog::Record record;
+    record.timestamp = message.serverReceivedTime.toMSecsSinceEpoch();
+    record.flags = message.flags.value;
+    record.channelName = this->channelName;
+    record.loginName = message.loginName;
+    record.displayName = message.displayName;
+    record.messageID = message.id;
+    record.text = message.searchText;
+    record.ircTags = message.ircTags;
+
+    if (this->pending.empty()) {
+        this->oldestPendingTime = QDateTime::currentDateTime();
+    }
+
+    this->pending.push_back(std::move(record));
+}
+
+bool StructuredLoggingChannel::writePending(const LogBatch &batch, bool force)
+{
+    if (batch.dateString != this->dateString || !this->fileHandle.isOpen()) {
+        // records of the previous day go into its file, the later ones into the new one
+        if (this->fileHandle.isOpen()) {
+            qint64 dayStart = QDateTime(batch.time.date()).toMSecsSinceEpoch();
+
+            auto firstOfDay = std::stable_partition(
+                this->pending.begin(), this->pending.end(),
+                [dayStart](const structuredlog::Record &record) {
+                    return record.timestamp < dayStart;
+                });
+
+            std::vector<structuredlog::Record> previousDay(
+                std::make_move_iterator(this->pending.begin()),
+                std::make_move_iterator(firstOfDay));
+            this->pending.erase(this->pending.begin(), firstOfDay);
+
+            this->writeBlock(previousDay, batch.sync);
+        }
+
+        this->dateString = batch.dateString;
+        this->openLogFile();
+    }
+
+    if (this->pending.empty()) {
+        return false;
+    }
+
+    if (force || batch.sync || this->pending.size() >= recordsPerBlock ||
+        this->oldestPendingTime.msecsTo(batch.time) >= maxBlockAge) {
+        this->writeBlock(this->pending, batch.sync);
+    }
+
+    return !this->pending.empty();
+}
+
+void StructuredLoggingChannel::writeBlock(std::vector<structuredlog::Record> &records, bool sync)
+{
+    if (records.empty()) {
+        return;
+    }
+
+    structuredlog::appendBlock(this->fileHandle, this->indexHandle, records);
+    records.clear();
+
+    this->fileHandle.flush();
+    this->indexHandle.flush();
+
+    if (sync) {
+        syncFile(this->fileHandle);
+        syncFile(this->indexHandle);
+    }
+}
+
+}  // namespace singletons
+}  // namespace chatterino
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "singletons/helper/loggingchannel.hpp"
+#include "singletons/helper/structuredlog.hpp"
+
+#include <vector>
+
+namespace chatterino {
+namespace singletons {
+
+// Compressed blocks of structured records in one file per day, see structuredlog.hpp. Records
+// are kept until there are enough for a block or the oldest one waited too long. With
+// syncAfterWrite every batch of the writer closes a block, so a crash loses no more than the
+// flush interval.
+class StructuredLoggingChannel : public LoggingChannel
+{
+    explicit StructuredLoggingChannel(const QString &_channelName, const QString &_baseDirectory,
+                                      LogWriter &_writer);
+
+public:
+    ~StructuredLoggingChannel() override;
+
+protected:
+    void appendMessage(const messages::Message &message) override;
+    bool writePending(const LogBatch &batch, bool force) override;
+
+private:
+    void openLogFile();
+    void writeBlock(std::vector<structuredlog::Record> &records, bool sync);
+
+    QFile fileHandle;
+    QFile indexHandle;
+
+    QString dateString;
+
+    std::vector<structuredlog::Record> pending;
+    QDateTime oldestPendingTime;
+
+    friend class LoggingManager;
+};
+
+}  // namespace singletons
+}  // namespace chatterino
@@ -2,6 +2,7 @@
 
 #include "application.hpp"
 #include "debug/log.hpp"
+#include "singletons/helper/structuredloggingchannel.hpp"
 #include "singletons/pathmanager.hpp"
 #include "singletons/settingsmanager.hpp"
 
@@ -15,7 +16,19 @@ namespace singletons {
 
 void LoggingManager::initialize()
 {
-    this->pathManager = getApp()->paths;
+    auto app = getApp();
+
+    this->pathManager = app->paths;
+
+    app->settings->logFlushInterval.connect(
+        [this](const int &value, auto) { this->writer.setFlushInterval(value); });
+    app->settings->logSyncAfterWrite.connect(
+        [this](const bool &value, auto) { this->writer.setSyncAfterWrite(value); });
+
+    // the channels are created again with the other backend
+    app->settings->structuredLogs.connect([this](const bool &, auto) {
+        this->loggingChannels.clear();  //
+    });
 }
 
 void LoggingManager::addMessage(const QString &channelName, messages::MessagePtr message)
@@ -28,7 +41,7 @@ void LoggingManager::addMessage(const QString &channelName, messages::MessagePtr
 
     auto it = this->loggingChannels.find(channelName);
     if (it == this->loggingChannels.end()) {
-        auto channel = new LoggingChannel(channelName, this->getDirectoryForChannel(channelName));
+        auto channel = this->createLoggingChannel(channelName);
         channel->addMessage(message);
         this->loggingChannels.emplace(channelName,
                                       std::unique_ptr<LoggingChannel>(std::move(channel)));
@@ -37,6 +50,24 @@ void LoggingManager::addMessage(const QString &channelName, messages::MessagePtr
     }
 }
 
+void LoggingManager::flush()
+{
+    this->writer.flush();
+}
+
+LoggingChannel *LoggingManager::createLoggingChannel(const QString &channelName)
+{
+    auto app = getApp();
+
+    QString directory = this->getDirectoryForChannel(channelName);
+
+    if (app->settings->structuredLogs) {
+        return new StructuredLoggingChannel(channelName, directory, this->writer);
+    }
+
+    return new TextLoggingChannel(channelName, directory, this->writer);
+}
+
 QString LoggingManager::getDirectoryForChannel(const QString &channelName)
 {
     if (channelName.startsWith("/whispers")) {
@@ -2,6 +2,7 @@
 
 #include "messages/message.hpp"
 #include "singletons/helper/loggingchannel.hpp"
+#include "singletons/helper/logwriter.hpp"
 
 #include <memory>
 
@@ -23,8 +24,17 @@ public:
 
     void addMessage(const QString &channelName, messages::MessagePtr message);
 
+    // Writes the messages that are still queued
+    void flush();
+
 private:
+    // declared before the channels, which flush it when they are destroyed
+    LogWriter writer;
+
     std::map<QString, std::unique_ptr<LoggingChannel>> loggingChannels;
+
+    // Picks the backend from the settings
+    LoggingChannel *createLoggingChannel(const QString &channelName);
     QString getDirectoryForChannel(const QString &channelName);
 };
 
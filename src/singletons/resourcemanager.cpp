@@ -294,6 +294,13 @@ ResourceManager::ResourceManager()
     this->split.up = QIcon(":/images/split/splitup.png");
     this->split.down = QIcon(":/images/split/splitdown.png");
     this->split.move = QIcon(":/images/split/splitmove.png");
+
+    this->defaultSubscriberBadge.image = this->badgeSubscriber;
+    this->defaultSubscriberBadge.tooltip = "Twitch Subscriber";
+    this->defaultSubscriberBadge.type = messages::MessageElement::BadgeSubscription;
+
+    this->rebuildGlobalBadgeResolver();
+
     qDebug() << "init ResourceManager";
 }
 
@@ -342,6 +349,8 @@ void ResourceManager::loadChannelData(const QString &roomID, bool bypassCache)
             }
         }
 
+        this->rebuildChannelBadgeResolver(ch);
+
         ch.loaded = true;
     });
 
@@ -351,12 +360,14 @@ void ResourceManager::loadChannelData(const QString &roomID, bool bypassCache)
         cheermoteURL, QThread::currentThread(), true, [this, roomID](const rapidjson::Document &d) {
             ResourceManager::Channel &ch = this->channels[roomID];
 
+            ch.jsonCheermoteSets.clear();
+            ch.cheermoteSets.clear();
+
             ParseCheermoteSets(ch.jsonCheermoteSets, d);
 
             for (auto &set : ch.jsonCheermoteSets) {
                 CheermoteSet cheermoteSet;
-                cheermoteSet.regex =
-                    QRegularExpression("^" + set.prefix.toLower() + "([1-9][0-9]*)$");
+                cheermoteSet.prefix = set.prefix.toLower();
 
                 for (auto &tier : set.tiers) {
                     Cheermote cheermote;
@@ -383,7 +394,12 @@ void ResourceManager::loadChannelData(const QString &roomID, bool bypassCache)
                               return lhs.minBits < rhs.minBits;  //
                           });
 
-                ch.cheermoteSets.emplace_back(cheermoteSet);
+                if (cheermoteSet.prefix == "cheer" &&
+                    this->defaultCheermoteSet.cheermotes.empty()) {
+                    this->defaultCheermoteSet = cheermoteSet;
+                }
+
+                ch.cheermoteSets.insert(cheermoteSet.prefix, std::move(cheermoteSet));
             }
         });
 }
@@ -412,6 +428,8 @@ void ResourceManager::loadDynamicTwitchBadges()
         }
 
         this->dynamicBadgesLoaded = true;
+
+        this->rebuildGlobalBadgeResolver();
     });
 }
 
@@ -447,5 +465,168 @@ void ResourceManager::loadChatterinoBadges()
     });
 }
 
+const ResourceManager::Cheermote *ResourceManager::CheermoteSet::getCheermote(
+    long long numBits) const
+{
+    auto it = std::upper_bound(this->cheermotes.begin(), this->cheermotes.end(), numBits,
+                               [](long long bits, const Cheermote &cheermote) {
+                                   return bits < cheermote.minBits;  //
+                               });
+
+    if (it == this->cheermotes.begin()) {
+        return nullptr;
+    }
+
+    return &*std::prev(it);
+}
+
+const ResourceManager::Cheermote *ResourceManager::Channel::matchCheermote(const QString &word,
+                                                                           int &numBits) const
+{
+    // Split the word into a prefix and a trailing amount without a leading zero
+    int amountStart = word.length();
+    while (amountStart > 0) {
+        QChar c = word.at(amountStart - 1);
+        if (c < '0' || c > '9') {
+            break;
+        }
+        amountStart--;
+    }
+
+    if (amountStart == 0 || amountStart == word.length() || word.at(amountStart) == '0') {
+        return nullptr;
+    }
+
+    auto setIt = this->cheermoteSets.constFind(word.left(amountStart).toLower());
+    if (setIt == this->cheermoteSets.constEnd()) {
+        return nullptr;
+    }
+
+    bool ok = false;
+    numBits = word.midRef(amountStart).toInt(&ok);
+    if (!ok) {
+        return nullptr;
+    }
+
+    return setIt.value().getCheermote(numBits);
+}
+
+const ResourceManager::Channel *ResourceManager::findChannel(const QString &roomID) const
+{
+    auto it = this->channels.find(roomID);
+
+    if (it == this->channels.end() || !it->second.loaded) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+const ResourceManager::ResolvedBadge *ResourceManager::resolveBadge(const Channel *channel,
+                                                                    const QString &badge) const
+{
+    const BadgeResolver &resolver =
+        channel != nullptr ? channel->badgeResolver : this->globalBadgeResolver;
+
+    auto it = resolver.constFind(badge);
+    if (it != resolver.constEnd()) {
+        return &it.value();
+    }
+
+    // Subscriber badge versions the channel does not have a custom image for
+    if (channel != nullptr && badge.startsWith("subscriber/")) {
+        return &this->defaultSubscriberBadge;
+    }
+
+    return nullptr;
+}
+
+void ResourceManager::rebuildGlobalBadgeResolver()
+{
+    using messages::MessageElement;
+
+    BadgeResolver resolver;
+
+    auto add = [&resolver](const QString &key, messages::Image *image, const QString &tooltip,
+                           MessageElement::Flags type) {
+        ResolvedBadge &badge = resolver[key];
+        badge.image = image;
+        badge.tooltip = tooltip;
+        badge.type = type;
+    };
+
+    if (this->dynamicBadgesLoaded) {
+        for (const auto &set : this->badgeSets) {
+            // Subscriber badges are resolved per channel
+            if (set.first == "subscriber") {
+                continue;
+            }
+
+            QString prefix = QString::fromStdString(set.first) + "/";
+            bool isBits = set.first == "bits";
+
+            for (const auto &version : set.second.versions) {
+                QString tooltip;
+                if (!isBits) {
+                    tooltip = "Twitch " + QString::fromStdString(version.second.title);
+                }
+
+                add(prefix + QString::fromStdString(version.first), version.second.badgeImage1x,
+                    tooltip, MessageElement::BadgeVanity);
+            }
+        }
+    }
+
+    // Bundled badges take precedence over the dynamic ones
+    add("staff/1", this->badgeStaff, "Twitch Staff", MessageElement::BadgeGlobalAuthority);
+    add("admin/1", this->badgeAdmin, "Twitch Admin", MessageElement::BadgeGlobalAuthority);
+    add("global_mod/1", this->badgeGlobalModerator, "Twitch Global Moderator",
+        MessageElement::BadgeGlobalAuthority);
+    // TODO: Implement custom FFZ moderator badge
+    add("moderator/1", this->badgeModerator, "Twitch Channel Moderator",
+        MessageElement::BadgeChannelAuthority);
+    add("turbo/1", this->badgeTurbo, "Twitch Turbo Subscriber",
+        MessageElement::BadgeGlobalAuthority);
+    add("broadcaster/1", this->badgeBroadcaster, "Twitch Broadcaster",
+        MessageElement::BadgeChannelAuthority);
+    add("premium/1", this->badgePremium, "Twitch Prime Subscriber", MessageElement::BadgeVanity);
+    add("partner/1", this->badgeVerified, "Twitch Verified", MessageElement::BadgeVanity);
+
+    this->globalBadgeResolver = std::move(resolver);
+
+    for (auto &channel : this->channels) {
+        if (channel.second.loaded) {
+            this->rebuildChannelBadgeResolver(channel.second);
+        }
+    }
+}
+
+void ResourceManager::rebuildChannelBadgeResolver(Channel &channel)
+{
+    BadgeResolver resolver = this->globalBadgeResolver;
+
+    auto bitsIt = channel.badgeSets.find("bits");
+    if (this->dynamicBadgesLoaded && bitsIt != channel.badgeSets.end()) {
+        for (const auto &version : bitsIt->second.versions) {
+            ResolvedBadge &badge = resolver["bits/" + QString::fromStdString(version.first)];
+            badge.image = version.second.badgeImage1x;
+            badge.tooltip.clear();
+            badge.type = messages::MessageElement::BadgeVanity;
+        }
+    }
+
+    auto subscriberIt = channel.badgeSets.find("subscriber");
+    if (subscriberIt != channel.badgeSets.end()) {
+        for (const auto &version : subscriberIt->second.versions) {
+            ResolvedBadge &badge = resolver["subscriber/" + QString::fromStdString(version.first)];
+            badge.image = version.second.badgeImage1x;
+            badge.tooltip = "Twitch " + QString::fromStdString(version.second.title);
+            badge.type = messages::MessageElement::BadgeSubscription;
+        }
+    }
+
+    channel.badgeResolver = std::move(resolver);
+}
+
 }  // namespace singletons
 }  // namespace chatterino
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "messages/messageelement.hpp"
 #include "util/emotemap.hpp"
 
+#include <QHash>
 #include <QRegularExpression>
 
 #include <map>
@@ -75,6 +77,19 @@ public:
 
     bool dynamicBadgesLoaded = false;
 
+    // A badge as it will be appended to a message, resolved from its raw "set/version" token
+    struct ResolvedBadge {
+        messages::Image *image = nullptr;
+        QString tooltip;
+        messages::MessageElement::Flags type = messages::MessageElement::BadgeVanity;
+    };
+
+    //      "set/version"
+    using BadgeResolver = QHash<QString, ResolvedBadge>;
+
+    // Global badges, used for channels whose data has not been loaded yet
+    BadgeResolver globalBadgeResolver;
+
     messages::Image *buttonBan;
     messages::Image *buttonTimeout;
 
@@ -111,14 +126,27 @@ public:
     };
 
     struct CheermoteSet {
-        QRegularExpression regex;
+        QString prefix;
+
+        // sorted by minBits
         std::vector<Cheermote> cheermotes;
+
+        // Returns the highest tier the amount qualifies for, or nullptr
+        const Cheermote *getCheermote(long long numBits) const;
     };
 
     struct Channel {
         std::map<std::string, BadgeSet> badgeSets;
         std::vector<JSONCheermoteSet> jsonCheermoteSets;
-        std::vector<CheermoteSet> cheermoteSets;
+
+        //    lowercase prefix
+        QHash<QString, CheermoteSet> cheermoteSets;
+
+        // Matches a word like "Kappa100" against the cheermote prefixes of this channel
+        const Cheermote *matchCheermote(const QString &word, int &numBits) const;
+
+        // Global badges merged with this channels badge overrides
+        BadgeResolver badgeResolver;
 
         bool loaded = false;
     };
@@ -126,6 +154,15 @@ public:
     //       channelId
     std::map<QString, Channel> channels;
 
+    // The global "cheer" cheermotes, taken from the first channel that loads them
+    CheermoteSet defaultCheermoteSet;
+
+    // Returns the loaded channel data for the given room, or nullptr. Never inserts.
+    const Channel *findChannel(const QString &roomID) const;
+
+    // Returns nullptr if the badge should not be shown
+    const ResolvedBadge *resolveBadge(const Channel *channel, const QString &badge) const;
+
     // Chatterino badges
     struct ChatterinoBadge {
         ChatterinoBadge(const std::string &_tooltip, messages::Image *_image)
@@ -144,6 +181,12 @@ public:
     void loadChannelData(const QString &roomID, bool bypassCache = false);
     void loadDynamicTwitchBadges();
     void loadChatterinoBadges();
+
+private:
+    ResolvedBadge defaultSubscriberBadge;
+
+    void rebuildGlobalBadgeResolver();
+    void rebuildChannelBadgeResolver(Channel &channel);
 };
 
 }  // namespace singletons
@@ -63,6 +63,15 @@ public:
 
     BoolSetting pauseChatHover = {"/behaviour/pauseChatHover", false};
 
+    // High traffic mode, reduces the effort spent on painting channels above a message rate
+    BoolSetting enableHighTrafficMode = {"/behaviour/highTrafficMode/enabled", true};
+    IntSetting highTrafficModeThreshold = {"/behaviour/highTrafficMode/messagesPerSecond", 40};
+
+    /// Connection
+    // channels are spread over more read connections once one has this many channels
+    IntSetting channelsPerReadConnection = {"/connection/channelsPerReadConnection", 100};
+    IntSetting maxReadConnections = {"/connection/maxReadConnections", 4};
+
     /// Commands
     BoolSetting allowCommandsAtEnd = {"/commands/allowCommandsAtEnd", false};
 
@@ -101,6 +110,9 @@ public:
 
     /// Logging
     BoolSetting enableLogging = {"/logging/enabled", false};
+    IntSetting logFlushInterval = {"/logging/flushInterval", 1000};
+    BoolSetting logSyncAfterWrite = {"/logging/syncAfterWrite", false};
+    BoolSetting structuredLogs = {"/logging/structured", false};
 
     QStringSetting pathHighlightSound = {"/highlighting/highlightSoundPath",
                                          "qrc:/sounds/ping2.wav"};
@@ -133,6 +133,22 @@ widgets::Window *WindowManager::windowAt(int index)
     return this->windows.at(index);
 }
 
+void WindowManager::forEachVisibleSplit(std::function<void(widgets::Split *)> func)
+{
+    util::assertInGuiThread();
+
+    for (widgets::Window *window : this->windows) {
+        widgets::SplitContainer *page = window->getNotebook().getSelectedPage();
+        if (page == nullptr) {
+            continue;
+        }
+
+        for (widgets::Split *split : page->getSplits()) {
+            func(split);
+        }
+    }
+}
+
 void WindowManager::initialize()
 {
     util::assertInGuiThread();
@@ -27,6 +27,9 @@ public:
     int windowCount();
     widgets::Window *windowAt(int index);
 
+    // Calls func for the splits on the selected tab of every window
+    void forEachVisibleSplit(std::function<void(widgets::Split *)> func);
+
     void save();
     void initialize();
     void closeAll();
@@ -7,10 +7,18 @@
 
 #include <QtAlgorithms>
 
+#include <algorithm>
 #include <utility>
 
 namespace chatterino {
 
+namespace {
+
+// tabbing through more completions than that isn't useful
+const size_t maxCompletions = 100;
+
+}  // namespace
+
 CompletionModel::CompletionModel(const QString &_channelName)
     : channelName(_channelName)
 {
@@ -22,46 +30,44 @@ void CompletionModel::refresh()
 
     auto app = getApp();
 
-    // User-specific: Twitch Emotes
-    // TODO: Fix this so it properly updates with the proper api. oauth token needs proper scope
-    for (const auto &m : app->emotes->twitchAccountEmotes) {
-        for (const auto &emoteName : m.second.emoteCodes) {
-            // XXX: No way to discern between a twitch global emote and sub emote right now
-            this->addString(emoteName, TaggedString::Type::TwitchGlobalEmote);
-        }
-    }
+    auto newGlobalEmotes = loadGlobalEmotes();
+    TaggedStrings newChannelEmotes;
 
-    // Global: BTTV Global Emotes
-    std::vector<std::string> &bttvGlobalEmoteCodes = app->emotes->bttvGlobalEmoteCodes;
-    for (const auto &m : bttvGlobalEmoteCodes) {
-        this->addString(m, TaggedString::Type::BTTVGlobalEmote);
-    }
+    // the global emotes are already completed, the channel only keeps what it adds
+    auto addString = [&](const std::string &code, TaggedString::Type type) {
+        QString str = qS(code);
+        QString key = str.toLower();
 
-    // Global: FFZ Global Emotes
-    std::vector<std::string> &ffzGlobalEmoteCodes = app->emotes->ffzGlobalEmoteCodes;
-    for (const auto &m : ffzGlobalEmoteCodes) {
-        this->addString(m, TaggedString::Type::FFZGlobalEmote);
-    }
+        for (auto it = findPrefix(*newGlobalEmotes, key);
+             it != newGlobalEmotes->end() && it->key == key; ++it) {
+            if (it->str == str) {
+                return;
+            }
+        }
+
+        newChannelEmotes.emplace_back(str, type);
+    };
 
     // Channel-specific: BTTV Channel Emotes
     std::vector<std::string> &bttvChannelEmoteCodes =
         app->emotes->bttvChannelEmoteCodes[this->channelName.toStdString()];
     for (const auto &m : bttvChannelEmoteCodes) {
-        this->addString(m, TaggedString::Type::BTTVChannelEmote);
+        addString(m, TaggedString::Type::BTTVChannelEmote);
     }
 
     // Channel-specific: FFZ Channel Emotes
     std::vector<std::string> &ffzChannelEmoteCodes =
         app->emotes->ffzChannelEmoteCodes[this->channelName.toStdString()];
     for (const auto &m : ffzChannelEmoteCodes) {
-        this->addString(m, TaggedString::Type::FFZChannelEmote);
+        addString(m, TaggedString::Type::FFZChannelEmote);
     }
 
-    // Global: Emojis
-    const auto &emojiShortCodes = app->emotes->emojiShortCodes;
-    for (const auto &m : emojiShortCodes) {
-        this->addString(":" + m + ":", TaggedString::Type::Emoji);
-    }
+    sortStrings(newChannelEmotes);
+
+    std::lock_guard<std::mutex> lock(this->emotesMutex);
+
+    this->globalEmotes = std::move(newGlobalEmotes);
+    this->channelEmotes = std::move(newChannelEmotes);
 
     // Channel-specific: Usernames
     // fourtf: only works with twitch chat
@@ -79,36 +85,181 @@ void CompletionModel::refresh()
     //    }
 }
 
-void CompletionModel::addString(const std::string &str, TaggedString::Type type)
+std::shared_ptr<const CompletionModel::TaggedStrings> CompletionModel::loadGlobalEmotes()
 {
-    this->addString(qS(str), type);
+    static std::mutex mutex;
+    static std::shared_ptr<const TaggedStrings> globalEmotes;
+    static int generation = 0;
+
+    auto app = getApp();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // if the emotes change while they are collected, the next refresh collects them again
+    int currentGeneration = app->emotes->getCompletionGeneration();
+    if (globalEmotes && generation == currentGeneration) {
+        return globalEmotes;
+    }
+
+    auto newGlobalEmotes = std::make_shared<TaggedStrings>();
+
+    auto addString = [&newGlobalEmotes](const std::string &code, TaggedString::Type type) {
+        newGlobalEmotes->emplace_back(qS(code), type);  //
+    };
+
+    // User-specific: Twitch Emotes
+    // TODO: Fix this so it properly updates with the proper api. oauth token needs proper scope
+    for (const auto &m : app->emotes->twitchAccountEmotes) {
+        for (const auto &emoteName : m.second.emoteCodes) {
+            // XXX: No way to discern between a twitch global emote and sub emote right now
+            addString(emoteName, TaggedString::Type::TwitchGlobalEmote);
+        }
+    }
+
+    // Global: BTTV Global Emotes
+    std::vector<std::string> &bttvGlobalEmoteCodes = app->emotes->bttvGlobalEmoteCodes;
+    for (const auto &m : bttvGlobalEmoteCodes) {
+        addString(m, TaggedString::Type::BTTVGlobalEmote);
+    }
+
+    // Global: FFZ Global Emotes
+    std::vector<std::string> &ffzGlobalEmoteCodes = app->emotes->ffzGlobalEmoteCodes;
+    for (const auto &m : ffzGlobalEmoteCodes) {
+        addString(m, TaggedString::Type::FFZGlobalEmote);
+    }
+
+    // Global: Emojis
+    const auto &emojiShortCodes = app->emotes->emojiShortCodes;
+    for (const auto &m : emojiShortCodes) {
+        addString(":" + m + ":", TaggedString::Type::Emoji);
+    }
+
+    sortStrings(*newGlobalEmotes);
+
+    debug::Log("[CompletionModel] Rebuilt the global emotes, {} codes", newGlobalEmotes->size());
+
+    globalEmotes = std::move(newGlobalEmotes);
+    generation = currentGeneration;
+
+    return globalEmotes;
 }
 
-void CompletionModel::addString(const QString &str, TaggedString::Type type)
+void CompletionModel::sortStrings(TaggedStrings &strings)
 {
-    std::lock_guard<std::mutex> lock(this->emotesMutex);
+    std::sort(strings.begin(), strings.end());
 
-    // Always add a space at the end of completions
-    this->emotes.insert({str + " ", type});
+    // an emote can be in more than one of the lists
+    strings.erase(std::unique(strings.begin(), strings.end(),
+                              [](const auto &a, const auto &b) { return a.str == b.str; }),
+                  strings.end());
 }
 
 void CompletionModel::addUser(const QString &str)
 {
-    auto ts = this->createUser(str + " ");
-    // Always add a space at the end of completions
-    std::pair<std::set<TaggedString>::iterator, bool> p = this->emotes.insert(ts);
-    if (!p.second) {
-        // No inseration was made, figure out if we need to replace the username.
-
-        if (p.first->str > ts.str) {
-            // Replace lowercase version of name with mixed-case version
-            this->emotes.erase(p.first);
-            auto result2 = this->emotes.insert(ts);
-            assert(result2.second);
-        } else {
-            p.first->timeAdded = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(this->emotesMutex);
+
+    TaggedString user(str, TaggedString::Type::Username);
+
+    auto it = std::lower_bound(this->users.begin(), this->users.end(), user.key,
+                               [](const TaggedString &a, const QString &key) {
+                                   return a.key < key;  //
+                               });
+
+    if (it == this->users.end() || it->key != user.key) {
+        this->users.insert(it, std::move(user));
+        return;
+    }
+
+    if (it->str > user.str) {
+        // Replace lowercase version of name with mixed-case version
+        it->str = user.str;
+    }
+
+    it->timeAdded = user.timeAdded;
+}
+
+void CompletionModel::addUsage(const QString &message)
+{
+    std::lock_guard<std::mutex> lock(this->emotesMutex);
+
+    auto now = std::chrono::steady_clock::now();
+
+    for (const QString &word : message.split(' ', QString::SkipEmptyParts)) {
+        // only what can be completed is counted
+        if (this->contains(word)) {
+            Usage &usage = this->usages[word];
+            usage.count++;
+            usage.lastUsed = now;
+        }
+    }
+}
+
+std::vector<QString> CompletionModel::getCompletions(const QString &prefix, size_t limit) const
+{
+    std::lock_guard<std::mutex> lock(this->emotesMutex);
+
+    struct Candidate {
+        const TaggedString *string;
+        int count;
+        std::chrono::steady_clock::time_point lastActive;
+    };
+
+    QString key = prefix.toLower();
+    std::vector<Candidate> candidates;
+
+    for (const TaggedStrings *strings : this->getAllStrings()) {
+        for (auto it = findPrefix(*strings, key); it != strings->end() && it->key.startsWith(key);
+             ++it) {
+            Usage usage = this->usages.value(it->str);
+
+            // users are active when they write something, emotes only when the user sends them
+            auto lastActive = usage.lastUsed;
+            if (!it->IsEmote()) {
+                lastActive = std::max(lastActive, it->timeAdded);
+            }
+
+            candidates.push_back(Candidate{&*it, usage.count, lastActive});
         }
     }
+
+    // most used first, then most recent, then alphabetically
+    auto isBetter = [](const Candidate &a, const Candidate &b) {
+        if (a.count != b.count) {
+            return a.count > b.count;
+        }
+
+        if (a.lastActive != b.lastActive) {
+            return a.lastActive > b.lastActive;
+        }
+
+        return *a.string < *b.string;
+    };
+
+    limit = std::min(limit, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + limit, candidates.end(), isBetter);
+
+    std::vector<QString> completions;
+    completions.reserve(limit);
+
+    for (size_t i = 0; i < limit; i++) {
+        // Always add a space at the end of completions
+        completions.push_back(candidates[i].string->str + " ");
+    }
+
+    return completions;
+}
+
+void CompletionModel::updateCompletions(const QString &prefix)
+{
+    std::vector<QString> newCompletions = this->getCompletions(prefix, maxCompletions);
+
+    // views ask for the rows when the reset ends, so the mutex can't be held until then
+    this->beginResetModel();
+    {
+        std::lock_guard<std::mutex> lock(this->completionsMutex);
+        this->completions = std::move(newCompletions);
+    }
+    this->endResetModel();
 }
 
 void CompletionModel::ClearExpiredStrings()
@@ -117,16 +268,50 @@ void CompletionModel::ClearExpiredStrings()
 
     auto now = std::chrono::steady_clock::now();
 
-    for (auto it = this->emotes.begin(); it != this->emotes.end();) {
-        const auto &taggedString = *it;
+    this->users.erase(std::remove_if(this->users.begin(), this->users.end(),
+                                     [&now](const TaggedString &taggedString) {
+                                         return taggedString.HasExpired(now);
+                                     }),
+                      this->users.end());
+}
+
+CompletionModel::TaggedStrings::const_iterator CompletionModel::findPrefix(
+    const TaggedStrings &strings, const QString &key)
+{
+    return std::lower_bound(strings.begin(), strings.end(), key,
+                            [](const TaggedString &a, const QString &key) {
+                                return a.key < key;  //
+                            });
+}
+
+std::vector<const CompletionModel::TaggedStrings *> CompletionModel::getAllStrings() const
+{
+    std::vector<const TaggedStrings *> strings;
+
+    // the model wasn't refreshed yet
+    if (this->globalEmotes) {
+        strings.push_back(this->globalEmotes.get());
+    }
+
+    strings.push_back(&this->channelEmotes);
+    strings.push_back(&this->users);
+
+    return strings;
+}
 
-        if (taggedString.HasExpired(now)) {
-            // debug::Log("String {} expired", taggedString.str);
-            it = this->emotes.erase(it);
-        } else {
-            ++it;
+bool CompletionModel::contains(const QString &str) const
+{
+    QString key = str.toLower();
+
+    for (const TaggedStrings *strings : this->getAllStrings()) {
+        for (auto it = findPrefix(*strings, key); it != strings->end() && it->key == key; ++it) {
+            if (it->str == str) {
+                return true;
+            }
         }
     }
+
+    return false;
 }
 
 }  // namespace chatterino
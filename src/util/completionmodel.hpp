@@ -3,14 +3,21 @@
 #include "common.hpp"
 
 #include <QAbstractListModel>
+#include <QHash>
 
 #include <chrono>
+#include <memory>
 #include <mutex>
-#include <set>
 #include <string>
+#include <vector>
 
 namespace chatterino {
 
+// Emotes and users are kept in arrays sorted by their lowercase text, so the completions of a
+// prefix are found with a binary search. The emotes every channel has are in one immutable array
+// that all models share, a model only has its own array for the channel emotes and the users.
+// The rows of the model are the best completions for the last prefix, ranked by how often and how
+// recently they were used.
 class CompletionModel : public QAbstractListModel
 {
     struct TaggedString {
@@ -29,6 +36,7 @@ class CompletionModel : public QAbstractListModel
 
         TaggedString(const QString &_str, Type _type)
             : str(_str)
+            , key(_str.toLower())
             , type(_type)
             , timeAdded(std::chrono::steady_clock::now())
         {
@@ -36,10 +44,13 @@ class CompletionModel : public QAbstractListModel
 
         QString str;
 
+        // the lowercase str, the arrays are sorted by it
+        QString key;
+
         // Type will help decide the lifetime of the tagged strings
         Type type;
 
-        mutable std::chrono::steady_clock::time_point timeAdded;
+        std::chrono::steady_clock::time_point timeAdded;
 
         bool HasExpired(const std::chrono::steady_clock::time_point &now) const
         {
@@ -65,32 +76,20 @@ class CompletionModel : public QAbstractListModel
 
         bool operator<(const TaggedString &that) const
         {
-            if (this->IsEmote()) {
-                if (that.IsEmote()) {
-                    int k = QString::compare(this->str, that.str, Qt::CaseInsensitive);
-                    if (k == 0) {
-                        return this->str > that.str;
-                    }
-
-                    return k < 0;
-                }
-
-                return true;
+            if (this->key != that.key) {
+                return this->key < that.key;
             }
 
-            if (that.IsEmote()) {
-                return false;
-            }
-
-            int k = QString::compare(this->str, that.str, Qt::CaseInsensitive);
-            if (k == 0) {
-                return false;
-            }
-
-            return k < 0;
+            return this->str < that.str;
         }
     };
 
+    // how often the user sent a completion
+    struct Usage {
+        int count = 0;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
 public:
     CompletionModel(const QString &_channelName);
 
@@ -101,37 +100,62 @@ public:
 
     QVariant data(const QModelIndex &index, int) const override
     {
-        std::lock_guard<std::mutex> lock(this->emotesMutex);
+        std::lock_guard<std::mutex> lock(this->completionsMutex);
+
+        if (index.row() < 0 || index.row() >= static_cast<int>(this->completions.size())) {
+            return QVariant();
+        }
 
-        // TODO: Implement more safely
-        auto it = this->emotes.begin();
-        std::advance(it, index.row());
-        return QVariant(it->str);
+        return QVariant(this->completions[index.row()]);
     }
 
     int rowCount(const QModelIndex &) const override
     {
-        std::lock_guard<std::mutex> lock(this->emotesMutex);
+        std::lock_guard<std::mutex> lock(this->completionsMutex);
 
-        return this->emotes.size();
+        return this->completions.size();
     }
 
     void refresh();
-    void addString(const std::string &str, TaggedString::Type type);
-    void addString(const QString &str, TaggedString::Type type);
 
     void addUser(const QString &str);
 
+    // Counts the completions in a message the user sent, they are ranked higher from then on
+    void addUsage(const QString &message);
+
+    // The best completions that start with the prefix, at most limit of them
+    std::vector<QString> getCompletions(const QString &prefix, size_t limit) const;
+
+    // Makes the best completions for the prefix the rows of the model
+    void updateCompletions(const QString &prefix);
+
     void ClearExpiredStrings();
 
 private:
-    TaggedString createUser(const QString &str)
-    {
-        return TaggedString{str, TaggedString::Type::Username};
-    }
+    using TaggedStrings = std::vector<TaggedString>;
+
+    // The global emotes, rebuilt after the emote manager loaded new ones
+    static std::shared_ptr<const TaggedStrings> loadGlobalEmotes();
+
+    // Sorts the strings and removes the duplicates
+    static void sortStrings(TaggedStrings &strings);
+
+    static TaggedStrings::const_iterator findPrefix(const TaggedStrings &strings,
+                                                    const QString &key);
+
+    // the arrays of the model, the global emotes first
+    std::vector<const TaggedStrings *> getAllStrings() const;
+
+    bool contains(const QString &str) const;
 
     mutable std::mutex emotesMutex;
-    std::set<TaggedString> emotes;
+    std::shared_ptr<const TaggedStrings> globalEmotes;
+    TaggedStrings channelEmotes;
+    TaggedStrings users;
+    QHash<QString, Usage> usages;
+
+    mutable std::mutex completionsMutex;
+    std::vector<QString> completions;
 
     QString channelName;
 };
@@ -0,0 +1,185 @@
+#include "util/metrics.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace chatterino {
+namespace util {
+namespace metrics {
+
+namespace {
+
+// Metrics register themselves during static initialization, so the registry is created on first
+// use instead of being a static object itself. The mutex is only taken when registering and when
+// taking a snapshot, never when a metric is updated.
+struct Registry {
+    std::mutex mutex;
+    std::vector<const Counter *> counters;
+    std::vector<const Gauge *> gauges;
+    std::vector<const Histogram *> histograms;
+};
+
+Registry &getRegistry()
+{
+    static Registry registry;
+
+    return registry;
+}
+
+template <typename T>
+void sortByName(std::vector<T> &items)
+{
+    std::sort(items.begin(), items.end(),
+              [](const T &a, const T &b) { return std::strcmp(a.name, b.name) < 0; });
+}
+
+}  // namespace
+
+Counter::Counter(const char *_name)
+    : name(_name)
+{
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.counters.push_back(this);
+}
+
+Gauge::Gauge(const char *_name)
+    : name(_name)
+{
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.gauges.push_back(this);
+}
+
+Histogram::Histogram(const char *_name)
+    : name(_name)
+{
+    for (auto &bucket : this->buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.histograms.push_back(this);
+}
+
+void Histogram::record(int64_t nanoseconds)
+{
+    uint64_t microseconds = uint64_t(std::max<int64_t>(0, nanoseconds)) / 1000;
+
+    // bucket 0 holds everything below 1us, bucket n everything below 2^n us
+    size_t bucket = 0;
+    while (microseconds != 0 && bucket < bucketCount - 1) {
+        microseconds >>= 1;
+        bucket++;
+    }
+
+    this->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+    this->totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const
+{
+    Snapshot snapshot;
+
+    snapshot.name = this->name;
+    snapshot.count = this->count.load(std::memory_order_relaxed);
+    snapshot.totalNanoseconds = this->totalNanoseconds.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < bucketCount; i++) {
+        snapshot.buckets[i] = this->buckets[i].load(std::memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+int64_t Histogram::Snapshot::getPercentile(double percentile) const
+{
+    uint64_t total = 0;
+    for (uint64_t bucket : this->buckets) {
+        total += bucket;
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    auto target = uint64_t(percentile * total);
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < bucketCount; i++) {
+        seen += this->buckets[i];
+
+        if (seen > target) {
+            return int64_t(1) << i;
+        }
+    }
+
+    return int64_t(1) << (bucketCount - 1);
+}
+
+Snapshot takeSnapshot()
+{
+    Snapshot snapshot;
+
+    {
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (const Counter *counter : registry.counters) {
+            snapshot.counters.push_back({counter->getName(), counter->get()});
+        }
+
+        for (const Gauge *gauge : registry.gauges) {
+            snapshot.gauges.push_back({gauge->getName(), gauge->get()});
+        }
+
+        for (const Histogram *histogram : registry.histograms) {
+            snapshot.histograms.push_back(histogram->getSnapshot());
+        }
+    }
+
+    sortByName(snapshot.counters);
+    sortByName(snapshot.gauges);
+    sortByName(snapshot.histograms);
+
+    return snapshot;
+}
+
+QString formatSnapshot(const Snapshot &snapshot)
+{
+    QString text;
+
+    for (const auto &counter : snapshot.counters) {
+        text += QString("%1: %2\n").arg(counter.name).arg(counter.value);
+    }
+
+    for (const auto &gauge : snapshot.gauges) {
+        text += QString("%1: %2\n").arg(gauge.name).arg(gauge.value);
+    }
+
+    for (const auto &histogram : snapshot.histograms) {
+        if (histogram.count == 0) {
+            text += QString("%1: -\n").arg(histogram.name);
+            continue;
+        }
+
+        text += QString("%1: n=%2 mean=%3us p50<%4us p99<%5us\n")
+                    .arg(histogram.name)
+                    .arg(histogram.count)
+                    .arg(histogram.totalNanoseconds / 1000.0 / histogram.count, 0, 'f', 1)
+                    .arg(histogram.getPercentile(0.5))
+                    .arg(histogram.getPercentile(0.99));
+    }
+
+    return text;
+}
+
+}  // namespace metrics
+}  // namespace util
+}  // namespace chatterino
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+namespace util {
+namespace metrics {
+
+// Metrics are created once as static objects and register themselves in the registry. Updating
+// them is a single relaxed atomic operation, so they can be used on the hottest paths. Every
+// metric lives in its own cache line so that threads updating different metrics don't contend.
+
+// Number of live objects or of events, changed with increase and decrease
+class alignas(64) Counter : boost::noncopyable
+{
+public:
+    explicit Counter(const char *name);
+
+    void increase(int64_t amount = 1)
+    {
+        this->value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void decrease(int64_t amount = 1)
+    {
+        this->value.fetch_sub(amount, std::memory_order_relaxed);
+    }
+
+    int64_t get() const
+    {
+        return this->value.load(std::memory_order_relaxed);
+    }
+
+    const char *getName() const
+    {
+        return this->name;
+    }
+
+private:
+    const char *name;
+    std::atomic<int64_t> value{0};
+};
+
+// Last reported value of something that is measured rather than counted, like a queue depth
+class alignas(64) Gauge : boost::noncopyable
+{
+public:
+    explicit Gauge(const char *name);
+
+    void set(int64_t newValue)
+    {
+        this->value.store(newValue, std::memory_order_relaxed);
+    }
+
+    int64_t get() const
+    {
+        return this->value.load(std::memory_order_relaxed);
+    }
+
+    const char *getName() const
+    {
+        return this->name;
+    }
+
+private:
+    const char *name;
+    std::atomic<int64_t> value{0};
+};
+
+// Distribution of durations in power of two buckets of microseconds, from <1us to >=2^20us
+class alignas(64) Histogram : boost::noncopyable
+{
+public:
+    static constexpr size_t bucketCount = 22;
+
+    struct Snapshot {
+        const char *name;
+        uint64_t count = 0;
+        int64_t totalNanoseconds = 0;
+        std::array<uint64_t, bucketCount> buckets{};
+
+        // Upper bound of the bucket the percentile falls into, in microseconds
+        int64_t getPercentile(double percentile) const;
+    };
+
+    // Records the time from its construction to its destruction
+    class ScopedTimer : boost::noncopyable
+    {
+    public:
+        explicit ScopedTimer(Histogram &_histogram)
+            : histogram(_histogram)
+        {
+            this->timer.start();
+        }
+
+        ~ScopedTimer()
+        {
+            this->histogram.record(this->timer.nsecsElapsed());
+        }
+
+    private:
+        Histogram &histogram;
+        QElapsedTimer timer;
+    };
+
+    explicit Histogram(const char *name);
+
+    void record(int64_t nanoseconds);
+
+    Snapshot getSnapshot() const;
+
+    const char *getName() const
+    {
+        return this->name;
+    }
+
+private:
+    const char *name;
+    std::atomic<uint64_t> count{0};
+    std::atomic<int64_t> totalNanoseconds{0};
+    std::array<std::atomic<uint64_t>, bucketCount> buckets;
+};
+
+struct CounterSnapshot {
+    const char *name;
+    int64_t value;
+};
+
+// Values of all registered metrics at one point in time, sorted by name
+struct Snapshot {
+    std::vector<CounterSnapshot> counters;
+    std::vector<CounterSnapshot> gauges;
+    std::vector<Histogram::Snapshot> histograms;
+};
+
+Snapshot takeSnapshot();
+
+// Human readable text of a snapshot, one metric per line
+QString formatSnapshot(const Snapshot &snapshot);
+
+}  // namespace metrics
+}  // namespace util
+}  // namespace chatterino
@@ -5,6 +5,7 @@
 #include "util/networkmanager.hpp"
 #include "util/networkrequester.hpp"
 #include "util/networkworker.hpp"
+#include "util/tracing.hpp"
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
@@ -239,6 +240,7 @@ public:
         QObject::connect(
             &requester, &NetworkRequester::requestUrl, worker,
             [timer, data = std::move(this->data), worker, onFinished{std::move(onFinished)}]() {
+                int64_t fetchStart = tracing::now();
                 QNetworkReply *reply = NetworkManager::NaM.get(data.request);
 
                 if (timer != nullptr) {
@@ -254,8 +256,13 @@ public:
                 }
 
                 QObject::connect(reply, &QNetworkReply::finished, worker,
-                                 [data = std::move(data), worker, reply,
+                                 [data = std::move(data), worker, reply, fetchStart,
                                   onFinished = std::move(onFinished)]() mutable {
+                                     if (tracing::isEnabled()) {
+                                         tracing::record(tracing::Stage::NetworkFetch, fetchStart,
+                                                         tracing::now());
+                                     }
+
                                      if (data.caller == nullptr) {
                                          QByteArray bytes = reply->readAll();
                                          data.writeToCache(bytes);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <utility>
+
+namespace chatterino {
+namespace util {
+
+// Unbounded lock-free queue for exactly one producer thread and one consumer thread. Every item is
+// a node of a linked list, the consumer owns the nodes up to the one it read last and the producer
+// only appends behind the last one.
+template <typename T>
+class SpscQueue : boost::noncopyable
+{
+public:
+    SpscQueue()
+        : head(new Node)
+        , tail(this->head)
+    {
+    }
+
+    ~SpscQueue()
+    {
+        while (this->head != nullptr) {
+            Node *next = this->head->next.load(std::memory_order_relaxed);
+            delete this->head;
+            this->head = next;
+        }
+    }
+
+    // Producer thread only
+    void push(T value)
+    {
+        Node *node = new Node;
+        node->value = std::move(value);
+
+        this->tail->next.store(node, std::memory_order_release);
+        this->tail = node;
+    }
+
+    // Consumer thread only, returns false if the queue is empty
+    bool pop(T &out)
+    {
+        Node *next = this->head->next.load(std::memory_order_acquire);
+
+        if (next == nullptr) {
+            return false;
+        }
+
+        out = std::move(next->value);
+
+        // the node that was read becomes the new dummy head
+        delete this->head;
+        this->head = next;
+
+        return true;
+    }
+
+private:
+    struct Node {
+        T value;
+        std::atomic<Node *> next{nullptr};
+    };
+
+    // consumer side
+    Node *head;
+
+    // producer side
+    Node *tail;
+};
+
+}  // namespace util
+}  // namespace chatterino
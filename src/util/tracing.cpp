@@ -0,0 +1,173 @@
+#include "util/tracing.hpp"
+
+#include <QFile>
+
+#include <algorithm>
+#include <chrono>
+
+namespace chatterino {
+namespace util {
+namespace tracing {
+
+namespace detail {
+
+std::atomic<int> enabledCount{0};
+
+}  // namespace detail
+
+namespace {
+
+const size_t capacity = 1 << 16;
+const char *stageNames[stageCount] = {
+    "irc receive", "message build", "highlight check", "add message", "layout",
+    "buffer paint", "paint event",  "image decode",    "network fetch",
+};
+
+const auto processStart = std::chrono::steady_clock::now();
+
+// A slot is written by one thread while other threads may read it. The sequence is 0 while the
+// slot is being written and the index of the event plus one afterwards, so a reader can tell
+// whether it copied a complete event.
+struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<int64_t> start{0};
+    std::atomic<int64_t> duration{0};
+    std::atomic<uint32_t> thread{0};
+    std::atomic<uint8_t> stage{0};
+};
+
+Slot slots[capacity];
+std::atomic<uint64_t> nextIndex{0};
+std::atomic<uint32_t> nextThread{1};
+
+uint32_t getThreadNumber()
+{
+    thread_local uint32_t number = nextThread.fetch_add(1, std::memory_order_relaxed);
+
+    return number;
+}
+
+}  // namespace
+
+const char *getStageName(Stage stage)
+{
+    return size_t(stage) < stageCount ? stageNames[size_t(stage)] : "unknown";
+}
+
+void enable()
+{
+    detail::enabledCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void disable()
+{
+    detail::enabledCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                processStart)
+        .count();
+}
+
+void record(Stage stage, int64_t start, int64_t end)
+{
+    uint64_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots[index % capacity];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end - start, std::memory_order_relaxed);
+    slot.thread.store(getThreadNumber(), std::memory_order_relaxed);
+    slot.stage.store(uint8_t(stage), std::memory_order_relaxed);
+
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::vector<Event> getEvents()
+{
+    uint64_t end = nextIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > capacity ? end - capacity : 0;
+
+    std::vector<Event> events;
+    events.reserve(end - begin);
+
+    for (uint64_t index = begin; index < end; index++) {
+        const Slot &slot = slots[index % capacity];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        Event event;
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.thread = slot.thread.load(std::memory_order_relaxed);
+        event.stage = Stage(slot.stage.load(std::memory_order_relaxed));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // skip slots that are being written or were overwritten while copying them
+        if (sequence != index + 1 || slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+std::array<StageSummary, stageCount> summarize(int64_t since)
+{
+    std::array<StageSummary, stageCount> summaries;
+
+    for (const Event &event : getEvents()) {
+        if (event.start < since || size_t(event.stage) >= stageCount) {
+            continue;
+        }
+
+        auto &summary = summaries[size_t(event.stage)];
+        summary.count++;
+        summary.total += event.duration;
+        summary.max = std::max(summary.max, event.duration);
+    }
+
+    return summaries;
+}
+
+bool exportChromeTrace(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QByteArray json = "{\"traceEvents\":[";
+    bool first = true;
+
+    // complete events, timestamps and durations are in microseconds
+    for (const Event &event : getEvents()) {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+
+        json += QString("{\"name\":\"%1\",\"cat\":\"chatterino\",\"ph\":\"X\",\"pid\":1,"
+                        "\"tid\":%2,\"ts\":%3,\"dur\":%4}")
+                    .arg(getStageName(event.stage))
+                    .arg(event.thread)
+                    .arg(event.start / 1000.0, 0, 'f', 3)
+                    .arg(event.duration / 1000.0, 0, 'f', 3)
+                    .toUtf8();
+    }
+
+    json += "],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.write(json) == json.size();
+}
+
+}  // namespace tracing
+}  // namespace util
+}  // namespace chatterino
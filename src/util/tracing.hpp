@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QString>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+namespace util {
+namespace tracing {
+
+// Trace points time the main stages of the message pipeline and write them into a ring buffer.
+// Recording is off until something enables it, until then a trace point only loads a flag.
+
+enum class Stage : uint8_t {
+    IrcReceive,
+    MessageBuild,
+    HighlightCheck,
+    AddMessage,
+    Layout,
+    BufferPaint,
+    PaintEvent,
+    ImageDecode,
+    NetworkFetch,
+
+    Count
+};
+
+constexpr size_t stageCount = size_t(Stage::Count);
+
+const char *getStageName(Stage stage);
+
+struct Event {
+    Stage stage;
+    uint32_t thread;
+
+    // nanoseconds since the start of the process
+    int64_t start;
+    int64_t duration;
+};
+
+struct StageSummary {
+    int count = 0;
+    int64_t total = 0;
+    int64_t max = 0;
+};
+
+namespace detail {
+
+extern std::atomic<int> enabledCount;
+
+}  // namespace detail
+
+// Enabling is counted, recording stops once every enable was matched by a disable
+void enable();
+void disable();
+
+inline bool isEnabled()
+{
+    return detail::enabledCount.load(std::memory_order_relaxed) > 0;
+}
+
+// Nanoseconds since the start of the process
+int64_t now();
+
+// Records a stage that ran from start to end, used for stages that don't fit into one scope
+void record(Stage stage, int64_t start, int64_t end);
+
+// The events that are still in the ring buffer, oldest first
+std::vector<Event> getEvents();
+
+// Count, total and maximum duration of every stage that started at or after since
+std::array<StageSummary, stageCount> summarize(int64_t since);
+
+// Writes the events in the ring buffer as Chrome trace JSON, which chrome://tracing and Perfetto
+// can open. Returns false if the file couldn't be written.
+bool exportChromeTrace(const QString &path);
+
+// Records the time from its construction to its destruction
+class Scope : boost::noncopyable
+{
+public:
+    explicit Scope(Stage _stage)
+        : stage(_stage)
+        , start(isEnabled() ? now() : -1)
+    {
+    }
+
+    ~Scope()
+    {
+        if (this->start >= 0) {
+            record(this->stage, this->start, now());
+        }
+    }
+
+private:
+    Stage stage;
+    int64_t start;
+};
+
+}  // namespace tracing
+}  // namespace util
+}  // namespace chatterino
@@ -12,12 +12,14 @@
 #include "ui_accountpopupform.h"
 #include "util/benchmark.hpp"
 #include "util/distancebetweenpoints.hpp"
+#include "util/tracing.hpp"
 #include "widgets/split.hpp"
 #include "widgets/tooltipwidget.hpp"
 
 #include <QClipboard>
 #include <QDebug>
 #include <QDesktopServices>
+#include <QElapsedTimer>
 #include <QGraphicsBlurEffect>
 #include <QPainter>
 
@@ -26,6 +28,7 @@
 #include <cmath>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 
 #define LAYOUT_WIDTH (this->width() - (this->scrollBar.isVisible() ? 16 : 4) * this->getScale())
 
@@ -58,11 +61,18 @@ ChannelView::ChannelView(BaseWidget *parent)
         this->goToBottom->setVisible(this->enableScrollingToBottom && this->scrollBar.isVisible() &&
                                      !this->scrollBar.isAtBottom());
 
+        if (this->batchedMessages != 0 && this->scrollBar.isAtBottom()) {
+            this->setBatchedMessages(0);
+        }
+
         this->queueUpdate();
     });
 
     this->repaintGifsConnection = app->windows->repaintGifs.connect([&] {
-        this->queueUpdate();  //
+        // animations are paused while the channel is busy
+        if (!this->highTrafficMode) {
+            this->queueUpdate();
+        }
     });
     this->layoutConnection = app->windows->layout.connect([&](Channel *channel) {
         if (channel == nullptr || this->channel.get() == channel) {
@@ -86,15 +96,25 @@ ChannelView::ChannelView(BaseWidget *parent)
         });
     });
 
-    //    this->updateTimer.setInterval(1000 / 60);
-    //    this->updateTimer.setSingleShot(true);
-    //    connect(&this->updateTimer, &QTimer::timeout, this, [this] {
-    //        if (this->updateQueued) {
-    //            this->updateQueued = false;
-    //            this->repaint();
-    //            this->updateTimer.start();
-    //        }
-    //    });
+    // in high traffic mode layouts and paints are coalesced into one frame per interval
+    this->updateTimer.setInterval(1000 / 20);
+    this->updateTimer.setSingleShot(true);
+    connect(&this->updateTimer, &QTimer::timeout, this, [this] {
+        if (this->layoutQueued) {
+            this->layoutQueued = false;
+            this->actuallyLayoutMessages();
+        }
+
+        if (this->updateQueued) {
+            this->updateQueued = false;
+            this->update();
+        }
+    });
+
+    this->highTrafficTimer.setInterval(1000);
+    connect(&this->highTrafficTimer, &QTimer::timeout, this,
+            [this] { this->updateHighTrafficMode(); });
+    this->highTrafficTimer.start();
 
     this->pauseTimeout.setSingleShot(true);
 
@@ -129,6 +149,7 @@ ChannelView::~ChannelView()
     this->repaintGifsConnection.disconnect();
     this->layoutConnection.disconnect();
     this->messageAddedAtStartConnection.disconnect();
+    this->messagesInsertedConnection.disconnect();
     this->messageReplacedConnection.disconnect();
 }
 
@@ -141,15 +162,62 @@ void ChannelView::themeRefreshEvent()
 
 void ChannelView::queueUpdate()
 {
-    //    if (this->updateTimer.isActive()) {
-    //        this->updateQueued = true;
-    //        return;
-    //    }
+    if (this->highTrafficMode) {
+        this->updateQueued = true;
+
+        if (!this->updateTimer.isActive()) {
+            this->updateTimer.start();
+        }
+        return;
+    }
+
+    this->update();
+}
+
+void ChannelView::updateHighTrafficMode()
+{
+    auto app = getApp();
+
+    bool enabled = false;
+
+    if (this->channel && app->settings->enableHighTrafficMode.getValue()) {
+        double rate = this->channel->statistics.getSnapshot().messagesPerSecond;
+        double threshold = app->settings->highTrafficModeThreshold.getValue();
+
+        // leave the mode only well below the threshold so it doesn't flip every second
+        enabled = this->highTrafficMode ? rate >= threshold * 0.75 : rate > threshold;
+    }
+
+    if (enabled == this->highTrafficMode) {
+        return;
+    }
+
+    this->highTrafficMode = enabled;
+
+    // the buffers contain the alternating backgrounds
+    auto snapshot = this->getMessagesSnapshot();
+    for (size_t i = 0; i < snapshot.getLength(); i++) {
+        snapshot[i]->invalidateBuffer();
+    }
+
+    if (!enabled) {
+        this->updateTimer.stop();
+        this->updateQueued = false;
+        this->layoutQueued = false;
+
+        this->actuallyLayoutMessages();
+    }
 
-    //    this->repaint();
     this->update();
+}
+
+void ChannelView::setBatchedMessages(int count)
+{
+    this->batchedMessages = count;
 
-    //    this->updateTimer.start();
+    this->goToBottom->getLabel().setText(
+        count == 0 ? QString("More messages below")
+                   : QString("%1 new messages below").arg(count));
 }
 
 void ChannelView::layoutMessages()
@@ -167,7 +235,10 @@ void ChannelView::actuallyLayoutMessages(bool causedByScrollbar)
 {
     auto app = getApp();
 
-    // BENCH(timer)
+    util::tracing::Scope trace(util::tracing::Stage::Layout);
+    QElapsedTimer timer;
+    timer.start();
+
     auto messagesSnapshot = this->getMessagesSnapshot();
 
     if (messagesSnapshot.getLength() == 0) {
@@ -178,6 +249,7 @@ void ChannelView::actuallyLayoutMessages(bool causedByScrollbar)
 
     bool redrawRequired = false;
     bool showScrollbar = false;
+    int invalidatedLayouts = 0;
 
     // Bool indicating whether or not we were showing all messages
     // True if one of the following statements are true:
@@ -200,7 +272,10 @@ void ChannelView::actuallyLayoutMessages(bool causedByScrollbar)
         for (size_t i = start; i < messagesSnapshot.getLength(); ++i) {
             auto message = messagesSnapshot[i];
 
-            redrawRequired |= message->layout(layoutWidth, this->getScale(), flags);
+            if (message->layout(layoutWidth, this->getScale(), flags)) {
+                redrawRequired = true;
+                invalidatedLayouts++;
+            }
 
             y += message->getHeight();
 
@@ -216,7 +291,9 @@ void ChannelView::actuallyLayoutMessages(bool causedByScrollbar)
     for (int i = (int)messagesSnapshot.getLength() - 1; i >= 0; i--) {
         auto *message = messagesSnapshot[i].get();
 
-        message->layout(layoutWidth, this->getScale(), flags);
+        if (message->layout(layoutWidth, this->getScale(), flags)) {
+            invalidatedLayouts++;
+        }
 
         h -= message->getHeight();
 
@@ -251,7 +328,13 @@ void ChannelView::actuallyLayoutMessages(bool causedByScrollbar)
         this->messageWasAdded = false;
     }
 
-    // MARK(timer);
+    if (this->performanceOverlay) {
+        this->performanceOverlay->addLayoutTime(timer.nsecsElapsed());
+    }
+
+    if (invalidatedLayouts > 0 && this->channel) {
+        this->channel->statistics.addLayoutInvalidations(invalidatedLayouts);
+    }
 
     if (redrawRequired) {
         this->queueUpdate();
@@ -334,6 +417,11 @@ const boost::optional<messages::MessageElement::Flags> &ChannelView::getOverride
     return this->overrideFlags;
 }
 
+void ChannelView::setShowChannelNames(bool value)
+{
+    this->showChannelNames = value;
+}
+
 messages::LimitedQueueSnapshot<MessageLayoutPtr> ChannelView::getMessagesSnapshot()
 {
     if (!this->paused) {
@@ -350,6 +438,7 @@ void ChannelView::setChannel(ChannelPtr newChannel)
     }
 
     this->messages.clear();
+    this->setBatchedMessages(0);
 
     // on new message
     this->messageAppendedConnection =
@@ -363,6 +452,10 @@ void ChannelView::setChannel(ChannelPtr newChannel)
             }
             this->lastMessageHasAlternateBackground = !this->lastMessageHasAlternateBackground;
 
+            if (this->performanceOverlay) {
+                this->performanceOverlay->messageQueued();
+            }
+
             if (this->messages.pushBack(MessageLayoutPtr(messageRef), deleted)) {
                 if (!this->paused) {
                     if (this->scrollBar.isAtBottom()) {
@@ -384,7 +477,18 @@ void ChannelView::setChannel(ChannelPtr newChannel)
             this->scrollBar.addHighlight(message->getScrollBarHighlight());
 
             this->messageWasAdded = true;
-            this->layoutMessages();
+
+            if (this->highTrafficMode) {
+                // laid out with the next frame, while scrolled up only the count is updated
+                if (!this->scrollBar.isAtBottom()) {
+                    this->setBatchedMessages(this->batchedMessages + 1);
+                }
+
+                this->layoutQueued = true;
+                this->queueUpdate();
+            } else {
+                this->layoutMessages();
+            }
         });
 
     this->messageAddedAtStartConnection =
@@ -417,6 +521,66 @@ void ChannelView::setChannel(ChannelPtr newChannel)
             this->layoutMessages();
         });
 
+    // on missed messages inserted in between
+    this->messagesInsertedConnection = newChannel->messagesInserted.connect(
+        [this](size_t index, std::vector<MessagePtr> &messages) {
+            std::vector<MessageLayoutPtr> messageRefs;
+            std::vector<ScrollbarHighlight> highlights;
+            messageRefs.reserve(messages.size());
+            highlights.reserve(messages.size());
+
+            for (const MessagePtr &message : messages) {
+                messageRefs.push_back(MessageLayoutPtr(new MessageLayout(message)));
+                highlights.push_back(message->getScrollBarHighlight());
+            }
+
+            size_t removedCount = this->messages.insert(index, messageRefs).size();
+            this->scrollBar.insertHighlights(index, highlights);
+
+            // keep the selection on the messages it was made on
+            auto shiftSelection = [&](SelectionItem &item) {
+                if (item.messageIndex >= int(index)) {
+                    item.messageIndex += int(messages.size());
+                }
+                item.messageIndex -= int(removedCount);
+            };
+            shiftSelection(this->selection.start);
+            shiftSelection(this->selection.end);
+            shiftSelection(this->selection.selectionMin);
+            shiftSelection(this->selection.selectionMax);
+
+            // the backgrounds alternate again from the first inserted message on
+            auto snapshot = this->messages.getSnapshot();
+            size_t first = index > removedCount ? index - removedCount : 0;
+            bool alternate = first > 0 && !(snapshot[first - 1]->flags &
+                                            MessageLayout::AlternateBackground);
+
+            for (size_t i = first; i < snapshot.getLength(); i++) {
+                MessageLayout *layout = snapshot[i].get();
+
+                if (bool(layout->flags & MessageLayout::AlternateBackground) != alternate) {
+                    layout->flags ^= MessageLayout::AlternateBackground;
+                    layout->invalidateBuffer();
+                }
+                alternate = !alternate;
+            }
+            this->lastMessageHasAlternateBackground = alternate;
+
+            if (!this->paused) {
+                if (this->scrollBar.isAtBottom()) {
+                    this->scrollBar.scrollToBottom();
+                } else if (qreal(index) <= this->scrollBar.getCurrentValue()) {
+                    // keep the messages that are currently visible in place
+                    this->scrollBar.offset(qreal(messages.size()) - qreal(removedCount));
+                } else {
+                    this->scrollBar.offset(-qreal(removedCount));
+                }
+            }
+
+            this->messageWasAdded = true;
+            this->layoutMessages();
+        });
+
     // on message removed
     this->messageRemovedConnection =
         newChannel->messageRemovedFromStart.connect([this](MessagePtr &) {
@@ -442,6 +606,54 @@ void ChannelView::setChannel(ChannelPtr newChannel)
             this->layoutMessages();
         });
 
+    // on all messages replaced
+    this->messagesResetConnection = newChannel->messagesReset.connect(
+        [this](std::vector<MessagePtr> &messages) {
+            // messages that stay keep their layout, so they don't have to be laid out again
+            std::unordered_map<const Message *, MessageLayoutPtr> layouts;
+            auto previous = this->messages.getSnapshot();
+            for (size_t i = 0; i < previous.getLength(); i++) {
+                layouts.emplace(previous[i]->getMessage(), previous[i]);
+            }
+
+            std::vector<MessageLayoutPtr> messageRefs;
+            std::vector<ScrollbarHighlight> highlights;
+            messageRefs.reserve(messages.size());
+            highlights.reserve(messages.size());
+
+            bool alternate = false;
+
+            for (const MessagePtr &message : messages) {
+                auto it = layouts.find(message.get());
+                MessageLayoutPtr layout = it != layouts.end()
+                                              ? it->second
+                                              : MessageLayoutPtr(new MessageLayout(message));
+
+                if (bool(layout->flags & MessageLayout::AlternateBackground) != alternate) {
+                    layout->flags ^= MessageLayout::AlternateBackground;
+                    layout->invalidateBuffer();
+                }
+                alternate = !alternate;
+
+                messageRefs.push_back(layout);
+                highlights.push_back(message->getScrollBarHighlight());
+            }
+            this->lastMessageHasAlternateBackground = alternate;
+
+            this->messages.clear();
+            this->messages.pushFront(messageRefs);
+
+            this->scrollBar.clearHighlights();
+            this->scrollBar.addHighlightsAtStart(highlights);
+
+            this->selection = Selection();
+            this->setBatchedMessages(0);
+            this->scrollBar.scrollToBottom();
+
+            this->messageWasAdded = true;
+            this->layoutMessages();
+        });
+
     auto snapshot = newChannel->getMessageSnapshot();
 
     for (size_t i = 0; i < snapshot.getLength(); i++) {
@@ -468,8 +680,30 @@ void ChannelView::detachChannel()
 {
     messageAppendedConnection.disconnect();
     messageAddedAtStartConnection.disconnect();
+    messagesInsertedConnection.disconnect();
     messageRemovedConnection.disconnect();
     messageReplacedConnection.disconnect();
+    messagesResetConnection.disconnect();
+}
+
+void ChannelView::setPerformanceOverlayVisible(bool visible)
+{
+    if (visible == this->isPerformanceOverlayVisible()) {
+        return;
+    }
+
+    if (visible) {
+        this->performanceOverlay.reset(new PerformanceOverlay(this));
+    } else {
+        this->performanceOverlay.reset();
+    }
+
+    this->update();
+}
+
+bool ChannelView::isPerformanceOverlayVisible() const
+{
+    return this->performanceOverlay != nullptr;
 }
 
 void ChannelView::pause(int msecTimeout)
@@ -522,6 +756,10 @@ messages::MessageElement::Flags ChannelView::getFlags() const
 
     MessageElement::Flags flags = app->settings->getWordFlags();
 
+    if (this->showChannelNames) {
+        flags = (MessageElement::Flags)(flags | MessageElement::ChannelName);
+    }
+
     Split *split = dynamic_cast<Split *>(this->parentWidget());
 
     if (split != nullptr) {
@@ -538,7 +776,9 @@ messages::MessageElement::Flags ChannelView::getFlags() const
 
 void ChannelView::paintEvent(QPaintEvent * /*event*/)
 {
-    //    BENCH(timer);
+    util::tracing::Scope trace(util::tracing::Stage::PaintEvent);
+    QElapsedTimer timer;
+    timer.start();
 
     QPainter painter(this);
 
@@ -547,7 +787,10 @@ void ChannelView::paintEvent(QPaintEvent * /*event*/)
     // draw messages
     this->drawMessages(painter);
 
-    //    MARK(timer);
+    if (this->performanceOverlay) {
+        this->performanceOverlay->addFrameTime(timer.nsecsElapsed());
+        this->performanceOverlay->paint(painter, this->rect());
+    }
 }
 
 // if overlays is false then it draws the message, if true then it draws things such as the grey
@@ -578,7 +821,8 @@ void ChannelView::drawMessages(QPainter &painter)
             isLastMessage = this->lastReadMessage.get() == layout;
         }
 
-        layout->paint(painter, y, i, this->selection, isLastMessage, windowFocused);
+        layout->paint(painter, y, i, this->selection, isLastMessage, windowFocused,
+                      this->highTrafficMode);
 
         y += layout->getHeight();
 
@@ -8,6 +8,7 @@
 #include "messages/selection.hpp"
 #include "widgets/accountpopup.hpp"
 #include "widgets/basewidget.hpp"
+#include "widgets/helper/performanceoverlay.hpp"
 #include "widgets/helper/rippleeffectlabel.hpp"
 #include "widgets/scrollbar.hpp"
 
@@ -40,9 +41,16 @@ public:
     bool getEnableScrollingToBottom() const;
     void setOverrideFlags(boost::optional<messages::MessageElement::Flags> value);
     const boost::optional<messages::MessageElement::Flags> &getOverrideFlags() const;
+
+    // Shows the channel every message was sent in, like the mentions channel does
+    void setShowChannelNames(bool value);
     void pause(int msecTimeout);
     void updateLastReadMessage();
 
+    // Shows frame times, layout times and pipeline stage timings on top of the messages
+    void setPerformanceOverlayVisible(bool visible);
+    bool isPerformanceOverlayVisible() const;
+
     void setChannel(ChannelPtr channel);
     messages::LimitedQueueSnapshot<messages::MessageLayoutPtr> getMessagesSnapshot();
     void layoutMessages();
@@ -80,21 +88,32 @@ protected:
 
 private:
     QTimer *layoutCooldown;
-    bool layoutQueued;
+    bool layoutQueued = false;
 
     QTimer updateTimer;
     bool updateQueued = false;
+
+    // Paints less in channels above the high traffic threshold, see updateHighTrafficMode
+    QTimer highTrafficTimer;
+    bool highTrafficMode = false;
+    int batchedMessages = 0;
+
     bool messageWasAdded = false;
     bool lastMessageHasAlternateBackground = false;
     bool paused = false;
     QTimer pauseTimeout;
     boost::optional<messages::MessageElement::Flags> overrideFlags;
+    bool showChannelNames = false;
     messages::MessageLayoutPtr lastReadMessage;
 
     messages::LimitedQueueSnapshot<messages::MessageLayoutPtr> snapshot;
 
     void detachChannel();
     void actuallyLayoutMessages(bool causedByScollbar = false);
+    void updateHighTrafficMode();
+
+    // Messages that arrived in high traffic mode while scrolled up
+    void setBatchedMessages(int count);
 
     void drawMessages(QPainter &painter);
     void setSelection(const messages::SelectionItem &start, const messages::SelectionItem &end);
@@ -124,8 +143,10 @@ private:
 
     pajlada::Signals::Connection messageAppendedConnection;
     pajlada::Signals::Connection messageAddedAtStartConnection;
+    pajlada::Signals::Connection messagesInsertedConnection;
     pajlada::Signals::Connection messageRemovedConnection;
     pajlada::Signals::Connection messageReplacedConnection;
+    pajlada::Signals::Connection messagesResetConnection;
     pajlada::Signals::Connection repaintGifsConnection;
     pajlada::Signals::Connection layoutConnection;
 
@@ -134,6 +155,8 @@ private:
 
     std::unordered_set<std::shared_ptr<messages::MessageLayout>> messagesOnScreen;
 
+    std::unique_ptr<PerformanceOverlay> performanceOverlay;
+
 private slots:
     void wordFlagsChanged()
     {
@@ -1,6 +1,6 @@
 #include "debugpopup.hpp"
 
-#include "util/debugcount.hpp"
+#include "util/metrics.hpp"
 
 #include <QFontDatabase>
 #include <QHBoxLayout>
@@ -17,8 +17,9 @@ DebugPopup::DebugPopup()
     auto *timer = new QTimer(this);
 
     timer->setInterval(1000);
-    QObject::connect(timer, &QTimer::timeout,
-                     [text] { text->setText(util::DebugCount::getDebugText()); });
+    QObject::connect(timer, &QTimer::timeout, [text] {
+        text->setText(util::metrics::formatSnapshot(util::metrics::takeSnapshot()));
+    });
     timer->start();
 
     text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
@@ -0,0 +1,140 @@
+#include "widgets/helper/performanceoverlay.hpp"
+
+#include "util/tracing.hpp"
+#include "widgets/helper/channelview.hpp"
+
+#include <QFontDatabase>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace chatterino {
+namespace widgets {
+
+namespace {
+
+const int64_t nanosecondsPerFrame = 16666667;
+
+QString formatMilliseconds(int64_t nanoseconds)
+{
+    return QString::number(nanoseconds / 1000000.0, 'f', 2);
+}
+
+}  // namespace
+
+PerformanceOverlay::PerformanceOverlay(ChannelView *view)
+{
+    util::tracing::enable();
+
+    // keep the stage timings current while nothing else repaints the view
+    this->updateTimer.setInterval(500);
+    QObject::connect(&this->updateTimer, &QTimer::timeout, view, [view] { view->update(); });
+    this->updateTimer.start();
+}
+
+PerformanceOverlay::~PerformanceOverlay()
+{
+    util::tracing::disable();
+}
+
+void PerformanceOverlay::addFrameTime(int64_t nanoseconds)
+{
+    this->frameTimes[this->frameCount % historySize] = nanoseconds;
+    this->frameCount++;
+
+    this->lastQueueDepth = this->queueDepth;
+    this->queueDepth = 0;
+}
+
+void PerformanceOverlay::addLayoutTime(int64_t nanoseconds)
+{
+    this->layoutTime = nanoseconds;
+}
+
+void PerformanceOverlay::messageQueued()
+{
+    this->queueDepth++;
+}
+
+void PerformanceOverlay::paint(QPainter &painter, const QRect &rect)
+{
+    size_t count = std::min(this->frameCount, historySize);
+
+    int64_t total = 0;
+    int64_t max = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += this->frameTimes[i];
+        max = std::max(max, this->frameTimes[i]);
+    }
+
+    int64_t last = count == 0 ? 0 : this->frameTimes[(this->frameCount - 1) % historySize];
+
+    QStringList lines;
+    lines << QString("frame %1 ms, avg %2, max %3")
+                 .arg(formatMilliseconds(last))
+                 .arg(formatMilliseconds(count == 0 ? 0 : total / int64_t(count)))
+                 .arg(formatMilliseconds(max));
+    lines << QString("layout %1 ms, queue %2")
+                 .arg(formatMilliseconds(this->layoutTime))
+                 .arg(this->lastQueueDepth);
+
+    // what every stage of the pipeline cost during the last second
+    auto summaries = util::tracing::summarize(util::tracing::now() - 1000000000);
+    for (size_t i = 0; i < summaries.size(); i++) {
+        const auto &summary = summaries[i];
+        if (summary.count == 0) {
+            continue;
+        }
+
+        lines << QString("%1: %2/s, %3 ms, max %4")
+                     .arg(util::tracing::getStageName(util::tracing::Stage(i)))
+                     .arg(summary.count)
+                     .arg(formatMilliseconds(summary.total))
+                     .arg(formatMilliseconds(summary.max));
+    }
+
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    painter.setFont(font);
+    QFontMetrics metrics(font);
+
+    int textWidth = 0;
+    for (const QString &line : lines) {
+        textWidth = std::max(textWidth, metrics.width(line));
+    }
+
+    const int padding = 4;
+    const int graphHeight = 32;
+    int width = std::max(textWidth, int(historySize) * 2) + padding * 2;
+    int height = lines.size() * metrics.height() + graphHeight + padding * 3;
+
+    QRect box(rect.right() - width - padding, rect.top() + padding, width, height);
+    painter.fillRect(box, QColor(0, 0, 0, 180));
+
+    // frame time graph, the line marks 60 frames per second
+    int graphBottom = box.top() + padding + graphHeight;
+    for (size_t i = 0; i < count; i++) {
+        size_t index = (this->frameCount - count + i) % historySize;
+        int64_t time = this->frameTimes[index];
+
+        int barHeight = int(std::min<int64_t>(graphHeight, time * graphHeight / 2 /
+                                                               nanosecondsPerFrame));
+        QColor color = time > nanosecondsPerFrame ? QColor(255, 80, 80) : QColor(80, 200, 80);
+
+        painter.fillRect(box.left() + padding + int(i) * 2, graphBottom - barHeight, 2, barHeight,
+                         color);
+    }
+
+    painter.setPen(QColor(255, 255, 255, 120));
+    painter.drawLine(box.left() + padding, graphBottom - graphHeight / 2, box.right() - padding,
+                     graphBottom - graphHeight / 2);
+
+    painter.setPen(Qt::white);
+    int y = graphBottom + padding + metrics.ascent();
+    for (const QString &line : lines) {
+        painter.drawText(box.left() + padding, y, line);
+        y += metrics.height();
+    }
+}
+
+}  // namespace widgets
+}  // namespace chatterino
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QPainter>
+#include <QTimer>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace chatterino {
+namespace widgets {
+
+class ChannelView;
+
+// Frame times, layout times and queue depth of a ChannelView along with the stage timings of the
+// last second, drawn on top of the messages. Tracing is recorded while an overlay exists.
+class PerformanceOverlay : boost::noncopyable
+{
+public:
+    explicit PerformanceOverlay(ChannelView *view);
+    ~PerformanceOverlay();
+
+    void addFrameTime(int64_t nanoseconds);
+    void addLayoutTime(int64_t nanoseconds);
+
+    // A message was added to the channel and waits for the next frame
+    void messageQueued();
+
+    void paint(QPainter &painter, const QRect &rect);
+
+private:
+    static constexpr size_t historySize = 60;
+
+    std::array<int64_t, historySize> frameTimes{};
+    size_t frameCount = 0;
+    int64_t layoutTime = 0;
+    int queueDepth = 0;
+    int lastQueueDepth = 0;
+
+    QTimer updateTimer;
+};
+
+}  // namespace widgets
+}  // namespace chatterino
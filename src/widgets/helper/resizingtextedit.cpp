@@ -98,6 +98,7 @@ void ResizingTextEdit::keyPressEvent(QKeyEvent *event)
             // First type pressing tab after modifying a message, we refresh our completion model
             this->completer->setModel(completionModel);
             completionModel->refresh();
+            completionModel->updateCompletions(currentCompletionPrefix);
             this->completionInProgress = true;
             this->completer->setCompletionPrefix(currentCompletionPrefix);
             this->completer->complete();
@@ -2,17 +2,61 @@
 
 #include <QHBoxLayout>
 #include <QLineEdit>
+#include <QPointer>
+#include <QThreadPool>
 #include <QVBoxLayout>
 
 #include "channel.hpp"
+#include "util/posttothread.hpp"
 #include "widgets/helper/channelview.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
 namespace chatterino {
 namespace widgets {
+
+namespace {
+
+// the result channel doesn't show more messages than that either
+const size_t maxResults = 1000;
+
+// typing restarts the timer, so the search runs once typing pauses
+const int searchDelay = 150;
+
+// how many messages are checked between looking whether the search was cancelled
+const size_t cancelCheckInterval = 256;
+
+// the mentions channel gets the same message right after the channel it was sent in
+const size_t duplicateLookback = 8;
+
+}  // namespace
+
 SearchPopup::SearchPopup()
 {
     this->initLayout();
     this->resize(400, 600);
+
+    // every search shows its results in the same channel, the results are only displayed and the
+    // channel doesn't log them again
+    this->resultChannel = ChannelPtr(new Channel("search", Channel::None));
+    this->channelView->setChannel(this->resultChannel);
+
+    this->searchTimer.setSingleShot(true);
+    this->searchTimer.setInterval(searchDelay);
+    QObject::connect(&this->searchTimer, &QTimer::timeout, [this] { this->performSearch(); });
+}
+
+SearchPopup::~SearchPopup()
+{
+    for (auto &connection : this->messageAppendedConnections) {
+        connection.disconnect();
+    }
+
+    if (this->cancelSearch) {
+        *this->cancelSearch = true;
+    }
 }
 
 void SearchPopup::initLayout()
@@ -30,7 +74,11 @@ void SearchPopup::initLayout()
             // SEARCH INPUT
             {
                 this->searchInput = new QLineEdit(this);
+                this->searchInput->setPlaceholderText(
+                    "from:user has:link is:highlighted after:yyyy-MM-dd before:yyyy-MM-dd");
                 layout2->addWidget(this->searchInput);
+                QObject::connect(this->searchInput, &QLineEdit::textChanged,
+                                 [this] { this->searchTimer.start(); });
                 QObject::connect(this->searchInput, &QLineEdit::returnPressed,
                                  [this] { this->performSearch(); });
             }
@@ -60,28 +108,249 @@ void SearchPopup::initLayout()
 
 void SearchPopup::setChannel(ChannelPtr channel)
 {
-    this->snapshot = channel->getMessageSnapshot();
-    this->performSearch();
+    this->setChannels({channel});
 
     this->setWindowTitle("Searching in " + channel->name + "s history");
 }
 
+void SearchPopup::setChannels(const std::vector<ChannelPtr> &channels)
+{
+    for (auto &connection : this->messageAppendedConnections) {
+        connection.disconnect();
+    }
+    this->messageAppendedConnections.clear();
+    this->channels.clear();
+
+    for (const ChannelPtr &channel : channels) {
+        this->channels.push_back(channel);
+
+        this->messageAppendedConnections.push_back(
+            channel->messageAppended.connect([this](messages::MessagePtr &message) {
+                this->onMessageAppended(message);  //
+            }));
+    }
+
+    // the results of several channels are told apart by the channel name in every message
+    this->channelView->setShowChannelNames(this->channels.size() > 1);
+
+    this->hasResults = false;
+    this->performSearch();
+
+    this->setWindowTitle("Searching in all channels");
+}
+
 void SearchPopup::performSearch()
 {
-    QString text = searchInput->text();
+    this->searchTimer.stop();
+
+    auto query = messages::SearchQuery::parse(this->searchInput->text());
+
+    // the search that is still running is outdated now
+    if (this->cancelSearch) {
+        *this->cancelSearch = true;
+    }
+
+    // every part is searched on its own worker, either the previous results or a channel
+    std::vector<std::vector<Result>> parts;
+    std::vector<std::weak_ptr<Channel>> channels;
+
+    // only complete results can be refined, results that were cut off at maxResults miss the older
+    // matches
+    if (this->hasResults && this->resultsComplete && !this->query.isEmpty() &&
+        query.isRefinementOf(this->query)) {
+        // the messages that arrived during the last search are not in the results yet, so they
+        // are kept to be checked as well
+        parts.push_back(this->results);
+        channels.emplace_back();
+    } else {
+        parts.resize(this->channels.size());
+        channels = this->channels;
+
+        this->arrivedMessages.clear();
+    }
+
+    if (parts.empty()) {
+        parts.emplace_back();
+        channels.emplace_back();
+    }
+
+    struct Search {
+        std::vector<std::vector<Result>> parts;
+        std::vector<std::weak_ptr<Channel>> channels;
+        std::atomic<size_t> remaining;
+    };
+
+    auto search = std::make_shared<Search>();
+    search->remaining = parts.size();
+    search->parts = std::move(parts);
+    search->channels = std::move(channels);
+
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    uint64_t generation = ++this->searchGeneration;
+    QPointer<SearchPopup> self(this);
+
+    this->pendingQuery = query;
+    this->cancelSearch = cancel;
+
+    auto byTime = [](const Result &a, const Result &b) {
+        return a.message->serverReceivedTime < b.message->serverReceivedTime;
+    };
 
-    ChannelPtr channel(new Channel("search", Channel::None));
+    for (size_t index = 0; index < search->parts.size(); index++) {
+        QThreadPool::globalInstance()->start(new util::LambdaRunnable([=] {
+            std::vector<Result> candidates = std::move(search->parts[index]);
+            std::vector<Result> results;
 
-    for (size_t i = 0; i < this->snapshot.getLength(); i++) {
-        messages::MessagePtr message = this->snapshot[i];
+            // the candidates of a channel are looked up here as well, the first search also
+            // builds the index of the channel
+            ChannelPtr channel = search->channels[index].lock();
+            if (channel && !*cancel) {
+                for (const messages::MessagePtr &message : channel->findSearchCandidates(query)) {
+                    candidates.push_back(Result{message});
+                }
+            }
+
+            // the last reference to a channel has to be released on the gui thread
+            if (channel) {
+                util::postToThread([channel = std::move(channel)] {});
+            }
+
+            for (size_t i = 0; i < candidates.size(); i++) {
+                if (i % cancelCheckInterval == 0 && *cancel) {
+                    break;
+                }
+
+                if (query.matches(*candidates[i].message)) {
+                    results.push_back(candidates[i]);
+                }
+            }
 
-        if (text.isEmpty() ||
-            message->searchText.indexOf(this->searchInput->text(), 0, Qt::CaseInsensitive) != -1) {
-            channel->addMessage(message);
+            std::stable_sort(results.begin(), results.end(), byTime);
+            search->parts[index] = std::move(results);
+
+            // the last worker that finishes merges the parts
+            if (--search->remaining != 0 || *cancel) {
+                return;
+            }
+
+            std::vector<std::vector<Result>> &merging = search->parts;
+
+            while (merging.size() > 1) {
+                std::vector<std::vector<Result>> merged;
+
+                for (size_t i = 0; i + 1 < merging.size(); i += 2) {
+                    merged.emplace_back();
+                    std::merge(merging[i].begin(), merging[i].end(), merging[i + 1].begin(),
+                               merging[i + 1].end(), std::back_inserter(merged.back()), byTime);
+                }
+
+                if (merging.size() % 2 == 1) {
+                    merged.push_back(std::move(merging.back()));
+                }
+
+                merging = std::move(merged);
+            }
+
+            // the mentions channel has messages of the other channels, they are shown once
+            std::unordered_set<const messages::Message *> seen;
+            std::vector<Result> shown;
+
+            for (Result &result : merging.front()) {
+                if (seen.insert(result.message.get()).second) {
+                    shown.push_back(std::move(result));
+                }
+            }
+
+            util::postToThread(
+                [self, generation, results = std::move(shown)]() mutable {
+                    if (self) {
+                        self->showResults(generation, std::move(results));
+                    }
+                });
+        }));
+    }
+}
+
+void SearchPopup::showResults(uint64_t generation, std::vector<Result> &&results)
+{
+    // a newer search was started since
+    if (generation != this->searchGeneration) {
+        return;
+    }
+
+    this->cancelSearch.reset();
+
+    this->query = this->pendingQuery;
+    this->results = std::move(results);
+    this->hasResults = true;
+
+    for (const Result &result : this->arrivedMessages) {
+        if (this->query.matches(*result.message) &&
+            !isRecentResult(this->results, result.message)) {
+            this->results.push_back(result);
         }
     }
+    this->arrivedMessages.clear();
+
+    this->resultsComplete = this->results.size() <= maxResults;
+    if (!this->resultsComplete) {
+        this->results.erase(this->results.begin(),
+                            this->results.end() - static_cast<std::ptrdiff_t>(maxResults));
+    }
+
+    std::vector<messages::MessagePtr> messages;
+    messages.reserve(this->results.size());
 
-    this->channelView->setChannel(channel);
+    for (const Result &result : this->results) {
+        messages.push_back(result.message);
+    }
+
+    // the view keeps the layouts of the results that stay, e.g. when a search is refined
+    this->resultChannel->resetMessages(messages);
+}
+
+void SearchPopup::onMessageAppended(const messages::MessagePtr &message)
+{
+    if (this->cancelSearch) {
+        if (!isRecentResult(this->arrivedMessages, message)) {
+            this->arrivedMessages.push_back(Result{message});
+        }
+        return;
+    }
+
+    if (!this->hasResults || !this->query.matches(*message) ||
+        isRecentResult(this->results, message)) {
+        return;
+    }
+
+    this->appendResult(Result{message});
 }
+
+void SearchPopup::appendResult(const Result &result)
+{
+    this->results.push_back(result);
+
+    if (this->results.size() > maxResults) {
+        this->results.erase(this->results.begin());
+        this->resultsComplete = false;
+    }
+
+    this->resultChannel->addMessage(result.message);
+}
+
+bool SearchPopup::isRecentResult(const std::vector<Result> &results,
+                                 const messages::MessagePtr &message)
+{
+    size_t end = results.size() > duplicateLookback ? results.size() - duplicateLookback : 0;
+
+    for (size_t i = results.size(); i > end; i--) {
+        if (results[i - 1].message == message) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 }  // namespace widgets
 }  // namespace chatterino
@@ -1,10 +1,16 @@
 #pragma once
 
-#include "messages/limitedqueuesnapshot.hpp"
 #include "messages/message.hpp"
+#include "messages/searchquery.hpp"
 #include "widgets/basewindow.hpp"
 
+#include <QTimer>
+#include <pajlada/signals/signal.hpp>
+
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 class QLineEdit;
 
@@ -20,16 +26,49 @@ class SearchPopup : public BaseWindow
 {
 public:
     SearchPopup();
+    ~SearchPopup() override;
 
     void setChannel(std::shared_ptr<Channel> channel);
 
+    // Searches all of the channels, every channel on its own worker. The results are merged by
+    // the time they were sent.
+    void setChannels(const std::vector<std::shared_ptr<Channel>> &channels);
+
 private:
-    messages::LimitedQueueSnapshot<messages::MessagePtr> snapshot;
+    struct Result {
+        messages::MessagePtr message;
+    };
+
+    std::vector<std::weak_ptr<Channel>> channels;
+    std::vector<pajlada::Signals::Connection> messageAppendedConnections;
+
     QLineEdit *searchInput;
     ChannelView *channelView;
+    QTimer searchTimer;
+
+    // the query of the results that are shown
+    messages::SearchQuery query;
+    std::vector<Result> results;
+    std::shared_ptr<Channel> resultChannel;
+    bool hasResults = false;
+
+    // false once results were cut off at the maximum, they can't be refined then
+    bool resultsComplete = false;
+
+    // the search that runs in the background, messages that arrive meanwhile are checked once
+    // it is done
+    messages::SearchQuery pendingQuery;
+    std::shared_ptr<std::atomic<bool>> cancelSearch;
+    uint64_t searchGeneration = 0;
+    std::vector<Result> arrivedMessages;
 
     void initLayout();
     void performSearch();
+    void showResults(uint64_t generation, std::vector<Result> &&results);
+    void onMessageAppended(const messages::MessagePtr &message);
+    void appendResult(const Result &result);
+    static bool isRecentResult(const std::vector<Result> &results,
+                               const messages::MessagePtr &message);
 };
 
 }  // namespace widgets
@@ -123,6 +123,9 @@ void SplitHeader::addDropdownItems(RippleEffectButton *label)
     this->dropdownMenu.addAction("Reload channel emotes", this, SLOT(menuReloadChannelEmotes()));
     this->dropdownMenu.addAction("Manual reconnect", this, SLOT(menuManualReconnect()));
     this->dropdownMenu.addSeparator();
+    this->dropdownMenu.addAction("Performance overlay", this->split, &Split::doTogglePerformanceOverlay, QKeySequence(tr("F11")));
+    this->dropdownMenu.addAction("Export performance trace", this->split, &Split::doExportPerformanceTrace);
+    this->dropdownMenu.addSeparator();
     this->dropdownMenu.addAction("Show changelog", this, SLOT(menuShowChangelog()));
     // clang-format on
 }
@@ -196,6 +199,32 @@ void SplitHeader::updateChannelText()
     this->tooltip = "";
 }
 
+QString SplitHeader::getTooltipText() const
+{
+    // the stream status already starts with the style
+    QString text =
+        this->isLive ? this->tooltip : "<style>.center    { text-align: center; }</style>";
+
+    auto channel = this->split->getChannel();
+    if (channel->isEmpty()) {
+        return this->isLive ? text : QString();
+    }
+
+    auto statistics = channel->statistics.getSnapshot();
+
+    text += "<p class = \"center\">" +
+            QString("%1 messages/s, %2 KB/s<br>%3 us to build a message<br>%4 highlights, %5 "
+                    "layout invalidations")
+                .arg(statistics.messagesPerSecond, 0, 'f', 1)
+                .arg(statistics.bytesPerSecond / 1024, 0, 'f', 1)
+                .arg(statistics.averageBuildMicroseconds, 0, 'f', 0)
+                .arg(statistics.highlights)
+                .arg(statistics.layoutInvalidations) +
+            "</p>";
+
+    return text;
+}
+
 void SplitHeader::updateModerationModeIcon()
 {
     auto app = getApp();
@@ -234,11 +263,15 @@ void SplitHeader::mousePressEvent(QMouseEvent *event)
 
 void SplitHeader::mouseMoveEvent(QMouseEvent *event)
 {
-    if (!this->dragging && this->isLive) {
-        auto tooltipWidget = TooltipWidget::getInstance();
-        tooltipWidget->moveTo(this, event->globalPos());
-        tooltipWidget->setText(tooltip);
-        tooltipWidget->show();
+    if (!this->dragging) {
+        QString tooltipText = this->getTooltipText();
+
+        if (!tooltipText.isEmpty()) {
+            auto tooltipWidget = TooltipWidget::getInstance();
+            tooltipWidget->moveTo(this, event->globalPos());
+            tooltipWidget->setText(tooltipText);
+            tooltipWidget->show();
+        }
     }
 
     if (this->dragging) {
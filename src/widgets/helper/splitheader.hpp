@@ -64,6 +64,9 @@ private:
 
     void initializeChannelSignals();
 
+    // Stream status if the channel is live and the statistics of the channel
+    QString getTooltipText() const;
+
     QString tooltip;
     bool isLive;
 
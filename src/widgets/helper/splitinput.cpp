@@ -144,6 +144,7 @@ void SplitInput::installKeyPressedEvent()
             sendMessage = sendMessage.replace('\n', ' ');
 
             c->sendMessage(sendMessage);
+            c->completionModel.addUsage(sendMessage);
             // don't add duplicate messages to message history
             if (this->prevMsg.isEmpty() || !this->prevMsg.endsWith(message))
                 this->prevMsg.append(message);
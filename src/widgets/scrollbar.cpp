@@ -44,11 +44,22 @@ void Scrollbar::addHighlight(ScrollbarHighlight highlight)
     this->highlights.pushBack(highlight, deleted);
 }
 
+void Scrollbar::clearHighlights()
+{
+    this->highlights.clear();
+}
+
 void Scrollbar::addHighlightsAtStart(const std::vector<ScrollbarHighlight> &_highlights)
 {
     this->highlights.pushFront(_highlights);
 }
 
+void Scrollbar::insertHighlights(size_t index,
+                                 const std::vector<ScrollbarHighlight> &_highlights)
+{
+    this->highlights.insert(index, _highlights);
+}
+
 void Scrollbar::replaceHighlight(size_t index, ScrollbarHighlight replacement)
 {
     this->highlights.replaceItem(index, replacement);
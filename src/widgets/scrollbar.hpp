@@ -25,7 +25,9 @@ public:
 
     void addHighlight(ScrollbarHighlight highlight);
     void addHighlightsAtStart(const std::vector<ScrollbarHighlight> &highlights);
+    void insertHighlights(size_t index, const std::vector<ScrollbarHighlight> &highlights);
     void replaceHighlight(size_t index, ScrollbarHighlight replacement);
+    void clearHighlights();
 
     void scrollToBottom(bool animate = false);
     bool isAtBottom() const;
@@ -13,6 +13,8 @@
 #define PAUSE_HOVERING "When hovering"
 
 #define LIMIT_CHATTERS_FOR_SMALLER_STREAMERS "Only fetch chatters list for viewers under X viewers"
+#define HIGH_TRAFFIC_MODE \
+    "Pause animations and repaint less often in busy channels, until they calm down again"
 
 namespace chatterino {
 namespace widgets {
@@ -51,6 +53,25 @@ BehaviourPage::BehaviourPage()
                             this->createSpinBox(app->settings->smallStreamerLimit, 10, 50000));
     }
 
+    {
+        auto group = layout.emplace<QGroupBox>("High traffic mode");
+        auto groupLayout = group.setLayoutType<QFormLayout>();
+        groupLayout->addRow(HIGH_TRAFFIC_MODE,
+                            this->createCheckBox("", app->settings->enableHighTrafficMode));
+
+        groupLayout->addRow("Messages per second that count as high traffic",
+                            this->createSpinBox(app->settings->highTrafficModeThreshold, 5, 1000));
+    }
+
+    {
+        auto group = layout.emplace<QGroupBox>("Connection (applies after reconnecting)");
+        auto groupLayout = group.setLayoutType<QFormLayout>();
+        groupLayout->addRow("Channels per read connection",
+                            this->createSpinBox(app->settings->channelsPerReadConnection, 10, 1000));
+        groupLayout->addRow("Maximum read connections",
+                            this->createSpinBox(app->settings->maxReadConnections, 1, 16));
+    }
+
     {
         auto group = layout.emplace<QGroupBox>("Misc");
         auto groupLayout = group.setLayoutType<QVBoxLayout>();
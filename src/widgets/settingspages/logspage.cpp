@@ -40,6 +40,15 @@ LogsPage::LogsPage()
     created->setOpenExternalLinks(true);
     layout.append(this->createCheckBox("Enable logging", app->settings->enableLogging));
 
+    auto form = layout.emplace<QFormLayout>().withoutMargin();
+    form->addRow("Write logs every (ms)",
+                 this->createSpinBox(app->settings->logFlushInterval, 100, 60000));
+    layout.append(this->createCheckBox("Sync log files to disk after every write (slower)",
+                                       app->settings->logSyncAfterWrite));
+    layout.append(this->createCheckBox(
+        "Write structured, compressed logs (.clog, read them with chatterino-logtool)",
+        app->settings->structuredLogs));
+
     layout->addStretch(1);
 }
 
@@ -9,6 +9,7 @@
 #include "singletons/thememanager.hpp"
 #include "singletons/windowmanager.hpp"
 #include "util/streamlink.hpp"
+#include "util/tracing.hpp"
 #include "util/urlfetch.hpp"
 #include "widgets/helper/debugpopup.hpp"
 #include "widgets/helper/searchpopup.hpp"
@@ -25,7 +26,9 @@
 #include <QDesktopServices>
 #include <QDockWidget>
 #include <QDrag>
+#include <QFileDialog>
 #include <QListWidget>
+#include <QMessageBox>
 #include <QMimeData>
 #include <QPainter>
 #include <QVBoxLayout>
@@ -79,6 +82,9 @@ Split::Split(QWidget *parent)
     // CTRL+F: Search
     CreateShortcut(this, "CTRL+F", &Split::doSearch);
 
+    // CTRL+SHIFT+F: Search all channels
+    CreateShortcut(this, "CTRL+SHIFT+F", &Split::doSearchAllChannels);
+
     // F12
     CreateShortcut(this, "F10", [] {
         auto *popup = new DebugPopup;
@@ -86,6 +92,9 @@ Split::Split(QWidget *parent)
         popup->show();
     });
 
+    // F11
+    CreateShortcut(this, "F11", &Split::doTogglePerformanceOverlay);
+
     // xd
     // CreateShortcut(this, "ALT+SHIFT+RIGHT", &Split::doIncFlexX);
     // CreateShortcut(this, "ALT+SHIFT+LEFT", &Split::doDecFlexX);
@@ -412,6 +421,31 @@ void Split::doOpenStreamlink()
     }
 }
 
+void Split::doTogglePerformanceOverlay()
+{
+    this->view.setPerformanceOverlayVisible(!this->view.isPerformanceOverlayVisible());
+}
+
+void Split::doExportPerformanceTrace()
+{
+    if (util::tracing::getEvents().empty()) {
+        QMessageBox::information(this, "Export performance trace",
+                                 "Nothing was recorded yet. Timings are recorded while the "
+                                 "performance overlay of a split is shown.");
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, "Export performance trace",
+                                                "chatterino-trace.json", "Trace (*.json)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    if (!util::tracing::exportChromeTrace(path)) {
+        QMessageBox::warning(this, "Export performance trace", "Unable to write " + path);
+    }
+}
+
 void Split::doOpenViewerList()
 {
     auto viewerDock = new QDockWidget("Viewer List", this);
@@ -515,11 +549,25 @@ void Split::doCopy()
 void Split::doSearch()
 {
     SearchPopup *popup = new SearchPopup();
+    popup->setAttribute(Qt::WA_DeleteOnClose);
 
     popup->setChannel(this->getChannel());
     popup->show();
 }
 
+void Split::doSearchAllChannels()
+{
+    std::vector<ChannelPtr> channels;
+    getApp()->twitch.server->forEachChannelAndSpecialChannels(
+        [&channels](ChannelPtr channel) { channels.push_back(channel); });
+
+    SearchPopup *popup = new SearchPopup();
+    popup->setAttribute(Qt::WA_DeleteOnClose);
+
+    popup->setChannels(channels);
+    popup->show();
+}
+
 template <typename Iter, typename RandomGenerator>
 static Iter select_randomly(Iter start, Iter end, RandomGenerator &g)
 {
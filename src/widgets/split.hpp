@@ -149,9 +149,18 @@ public slots:
     // Open a search popup
     void doSearch();
 
+    // Open a search popup for all channels
+    void doSearchAllChannels();
+
     // Open viewer list of the channel
     void doOpenViewerList();
 
+    // Show or hide frame and stage timings on top of the messages
+    void doTogglePerformanceOverlay();
+
+    // Save the recorded stage timings as Chrome trace JSON
+    void doExportPerformanceTrace();
+
     void doIncFlexX();
     void doDecFlexX();
     void doIncFlexY();
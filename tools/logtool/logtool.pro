@@ -0,0 +1,18 @@
+# Exports and searches the structured logs (.clog) written by chatterino.
+# Build it separately from the main project:
+#   qmake tools/logtool/logtool.pro && make
+
+QT            -= gui
+QT            += core
+CONFIG        += c++14 console
+CONFIG        -= app_bundle
+TARGET         = chatterino-logtool
+TEMPLATE       = app
+INCLUDEPATH   += ../../src/
+
+SOURCES += \
+    main.cpp \
+    ../../src/singletons/helper/structuredlog.cpp
+
+HEADERS += \
+    ../../src/singletons/helper/structuredlog.hpp
@@ -0,0 +1,196 @@
+#include "singletons/helper/structuredlog.hpp"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#include <limits>
+
+using namespace chatterino::singletons;
+
+namespace {
+
+struct Filter {
+    QString user;
+    qint64 from = std::numeric_limits<qint64>::min();
+    qint64 to = std::numeric_limits<qint64>::max();
+
+    QString text;
+    QRegularExpression regex;
+    bool useRegex = false;
+
+    bool matchesBlock(const structuredlog::BlockInfo &block) const
+    {
+        if (!block.overlaps(this->from, this->to)) {
+            return false;
+        }
+
+        return this->user.isEmpty() || block.mayContainUser(this->user);
+    }
+
+    bool matches(const structuredlog::Record &record) const
+    {
+        if (record.timestamp < this->from || record.timestamp > this->to) {
+            return false;
+        }
+
+        if (!this->user.isEmpty() &&
+            record.loginName.compare(this->user, Qt::CaseInsensitive) != 0) {
+            return false;
+        }
+
+        if (this->useRegex) {
+            return this->regex.match(record.text).hasMatch();
+        }
+
+        return this->text.isEmpty() || record.text.contains(this->text, Qt::CaseInsensitive);
+    }
+};
+
+bool parseTime(const QString &string, qint64 &out)
+{
+    QDateTime dateTime = QDateTime::fromString(string, Qt::ISODate);
+
+    if (!dateTime.isValid()) {
+        return false;
+    }
+
+    out = dateTime.toMSecsSinceEpoch();
+    return true;
+}
+
+void print(QTextStream &out, const structuredlog::Record &record, bool withTags)
+{
+    out << "[" << QDateTime::fromMSecsSinceEpoch(record.timestamp).toString(Qt::ISODate) << "] #"
+        << record.channelName << " " << record.text;
+
+    if (withTags && !record.ircTags.isEmpty()) {
+        out << "  @" << record.ircTags;
+    }
+
+    out << "\n";
+}
+
+// Prints the matching records of a log, returns the number of matches or -1 if it can't be read
+int scan(const QString &path, const Filter &filter, bool withTags, QTextStream &out)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    int matches = 0;
+
+    // the index skips the blocks that can't match without decompressing them
+    for (const auto &block : structuredlog::readIndex(path)) {
+        if (!filter.matchesBlock(block)) {
+            continue;
+        }
+
+        std::vector<structuredlog::Record> records;
+        if (!structuredlog::readBlock(file, block, records)) {
+            QTextStream(stderr) << path << ": damaged block at " << block.offset << "\n";
+            continue;
+        }
+
+        for (const auto &record : records) {
+            if (filter.matches(record)) {
+                print(out, record, withTags);
+                matches++;
+            }
+        }
+    }
+
+    return matches;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("chatterino-logtool");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Exports and searches structured chatterino logs (.clog)");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "export or grep");
+    parser.addPositionalArgument("args", "export: <file>...  grep: <pattern> <file>...");
+
+    QCommandLineOption userOption("user", "Only messages of <login>", "login");
+    QCommandLineOption fromOption("from", "Only messages at or after <time> (ISO 8601)", "time");
+    QCommandLineOption toOption("to", "Only messages at or before <time> (ISO 8601)", "time");
+    QCommandLineOption regexOption("regex", "The grep pattern is a regular expression");
+    QCommandLineOption tagsOption("tags", "Print the irc tags of the messages");
+    parser.addOptions({userOption, fromOption, toOption, regexOption, tagsOption});
+
+    parser.process(app);
+
+    QStringList args = parser.positionalArguments();
+    QTextStream err(stderr);
+
+    if (args.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    QString command = args.takeFirst();
+
+    Filter filter;
+    filter.user = parser.value(userOption);
+
+    if (parser.isSet(fromOption) && !parseTime(parser.value(fromOption), filter.from)) {
+        err << "Invalid time: " << parser.value(fromOption) << "\n";
+        return 1;
+    }
+    if (parser.isSet(toOption) && !parseTime(parser.value(toOption), filter.to)) {
+        err << "Invalid time: " << parser.value(toOption) << "\n";
+        return 1;
+    }
+
+    if (command == "grep") {
+        if (args.isEmpty()) {
+            parser.showHelp(1);
+        }
+
+        filter.text = args.takeFirst();
+        filter.useRegex = parser.isSet(regexOption);
+
+        if (filter.useRegex) {
+            filter.regex = QRegularExpression(filter.text);
+
+            if (!filter.regex.isValid()) {
+                err << "Invalid regular expression: " << filter.regex.errorString() << "\n";
+                return 1;
+            }
+        }
+    } else if (command != "export") {
+        err << "Unknown command: " << command << "\n";
+        return 1;
+    }
+
+    if (args.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    QTextStream out(stdout);
+    out.setCodec("UTF-8");
+
+    int matches = 0;
+
+    for (const QString &path : args) {
+        int fileMatches = scan(path, filter, parser.isSet(tagsOption), out);
+
+        if (fileMatches < 0) {
+            err << "Unable to open " << path << "\n";
+            continue;
+        }
+
+        matches += fileMatches;
+    }
+
+    // like grep, nothing found is an error for scripts
+    return command == "grep" && matches == 0 ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+# Generates src/messages/tldtable.hpp, the perfect hash table LinkParser looks up top level domains
+# in. Run it from the repository root after changing the list below.
+#
+# The table uses "hash and displace": the first hash picks a bucket, each bucket stores the seed
+# of a second hash that maps all of its tlds into distinct free slots. hash_tld has to match
+# hashTld in src/messages/linkparser.cpp.
+
+import os
+import sys
+
+TLDS = [
+    'ac', 'academy', 'ad', 'ae', 'aero', 'af', 'ag', 'agency', 'ai', 'al', 'am', 'amazon', 'ao',
+    'app', 'apple', 'aq', 'ar', 'arpa', 'art', 'as', 'asia', 'at', 'au', 'audio', 'aw', 'ax', 'az',
+    'ba', 'bar', 'bb', 'bd', 'be', 'berlin', 'bet', 'bf', 'bg', 'bh', 'bi', 'biz', 'bj', 'black',
+    'blog', 'blue', 'bm', 'bn', 'bo', 'bq', 'br', 'bs', 'bt', 'business', 'bw', 'by', 'bz', 'ca',
+    'care', 'casino', 'cat', 'cc', 'cd', 'center', 'cf', 'cg', 'ch', 'chat', 'ci', 'city', 'ck',
+    'cl', 'cloud', 'club', 'cm', 'cn', 'co', 'codes', 'com', 'community', 'company', 'cool',
+    'coop', 'cr', 'cu', 'cv', 'cw', 'cx', 'cy', 'cz', 'de', 'design', 'dev', 'digital', 'dj', 'dk',
+    'dm', 'do', 'dog', 'download', 'dz', 'ec', 'edu', 'education', 'ee', 'eg', 'email', 'er', 'es',
+    'et', 'eu', 'events', 'fail', 'fan', 'fans', 'fi', 'film', 'finance', 'fj', 'fk', 'fm', 'fo',
+    'fr', 'fun', 'fyi', 'ga', 'gallery', 'game', 'games', 'gay', 'gb', 'gd', 'ge', 'gf', 'gg',
+    'gh', 'gi', 'gl', 'gm', 'gmbh', 'gn', 'gold', 'google', 'gov', 'gp', 'gq', 'gr', 'green',
+    'group', 'gs', 'gt', 'gu', 'guide', 'gw', 'gy', 'health', 'help', 'hk', 'hm', 'hn', 'host',
+    'hosting', 'hr', 'ht', 'hu', 'icu', 'id', 'ie', 'il', 'im', 'in', 'inc', 'info', 'int', 'io',
+    'iq', 'ir', 'is', 'it', 'je', 'jm', 'jo', 'jobs', 'jp', 'ke', 'kg', 'kh', 'ki', 'km', 'kn',
+    'kp', 'kr', 'kw', 'ky', 'kz', 'la', 'land', 'lb', 'lc', 'li', 'life', 'link', 'live', 'lk',
+    'llc', 'lol', 'london', 'love', 'lr', 'ls', 'lt', 'ltd', 'lu', 'lv', 'ly', 'ma', 'market',
+    'mc', 'md', 'me', 'media', 'mg', 'mh', 'microsoft', 'mil', 'mk', 'ml', 'mm', 'mn', 'mo',
+    'mobi', 'moe', 'mom', 'money', 'movie', 'mp', 'mq', 'mr', 'ms', 'mt', 'mu', 'museum', 'music',
+    'mv', 'mw', 'mx', 'my', 'mz', 'na', 'name', 'nc', 'ne', 'net', 'network', 'news', 'nf', 'ng',
+    'ni', 'ninja', 'nl', 'no', 'np', 'nr', 'nu', 'nyc', 'nz', 'om', 'one', 'online', 'org', 'pa',
+    'page', 'paris', 'party', 'pe', 'pf', 'pg', 'ph', 'photo', 'photos', 'pics', 'pictures',
+    'pink', 'pk', 'pl', 'place', 'plus', 'pm', 'pn', 'poker', 'porn', 'post', 'pr', 'pro', 'ps',
+    'pt', 'pub', 'pw', 'py', 'qa', 'radio', 're', 'red', 'review', 'reviews', 'ro', 'rocks', 'rs',
+    'ru', 'run', 'rw', 'sa', 'sb', 'sc', 'school', 'science', 'sd', 'se', 'sexy', 'sg', 'sh',
+    'shop', 'show', 'si', 'site', 'sk', 'sl', 'sm', 'sn', 'so', 'social', 'software', 'solutions',
+    'space', 'sr', 'ss', 'st', 'store', 'stream', 'studio', 'su', 'support', 'sv', 'sx', 'sy',
+    'systems', 'sz', 'tc', 'td', 'team', 'tech', 'tel', 'tf', 'tg', 'th', 'tickets', 'tips', 'tj',
+    'tk', 'tl', 'tm', 'tn', 'to', 'today', 'tokyo', 'tools', 'top', 'tr', 'travel', 'tt', 'tube',
+    'tv', 'tw', 'tz', 'ua', 'ug', 'uk', 'university', 'us', 'uy', 'uz', 'va', 'vc', 've', 'vg',
+    'vi', 'video', 'vip', 'vn', 'vu', 'watch', 'website', 'wf', 'wiki', 'work', 'world', 'ws',
+    'wtf', 'xxx', 'xyz', 'ye', 'youtube', 'yt', 'za', 'zm', 'zone', 'zw',
+]
+
+BUCKET_COUNT = 128
+SLOT_COUNT = 1024
+MAX_SEED = 1 << 20
+
+MASK = 0xFFFFFFFF
+
+
+def hash_tld(seed, tld):
+    # fnv-1a followed by the murmur3 finalizer, on the lowercase characters
+    value = (2166136261 ^ ((seed * 0x9E3779B9) & MASK)) & MASK
+
+    for char in tld.lower():
+        value ^= ord(char)
+        value = (value * 16777619) & MASK
+
+    value ^= value >> 16
+    value = (value * 0x85EBCA6B) & MASK
+    value ^= value >> 13
+    value = (value * 0xC2B2AE35) & MASK
+    value ^= value >> 16
+
+    return value
+
+
+def build_table(tlds):
+    buckets = [[] for _ in range(BUCKET_COUNT)]
+    for index, tld in enumerate(tlds):
+        buckets[hash_tld(0, tld) & (BUCKET_COUNT - 1)].append(index)
+
+    displacements = [0] * BUCKET_COUNT
+    slots = [-1] * SLOT_COUNT
+
+    # place the largest buckets first while there are still many free slots
+    order = sorted(range(BUCKET_COUNT), key=lambda bucket: -len(buckets[bucket]))
+
+    for bucket in order:
+        items = buckets[bucket]
+        if not items:
+            break
+
+        for seed in range(1, MAX_SEED):
+            placed = [hash_tld(seed, tlds[item]) & (SLOT_COUNT - 1) for item in items]
+
+            if len(set(placed)) == len(placed) and all(slots[slot] == -1 for slot in placed):
+                for item, slot in zip(items, placed):
+                    slots[slot] = item
+                displacements[bucket] = seed
+                break
+        else:
+            sys.exit("no seed places bucket %d, increase SLOT_COUNT" % bucket)
+
+    # every tld has to be found the way LinkParser looks it up
+    for index, tld in enumerate(tlds):
+        seed = displacements[hash_tld(0, tld) & (BUCKET_COUNT - 1)]
+        assert slots[hash_tld(seed, tld) & (SLOT_COUNT - 1)] == index, tld
+
+    return displacements, slots
+
+
+def format_array(values, per_line):
+    lines = []
+    for start in range(0, len(values), per_line):
+        lines.append("    " + " ".join("%s," % value for value in values[start:start + per_line]))
+    return "\n".join(lines)
+
+
+def main():
+    tlds = sorted(set(TLDS))
+    if len(tlds) >= 1 << 15:
+        sys.exit("too many tlds for int16_t slots")
+
+    displacements, slots = build_table(tlds)
+
+    output = """// Generated by tools/tldtable/generate.py, don't edit it by hand
+
+#pragma once
+
+#include <cstdint>
+
+namespace chatterino {
+namespace messages {
+namespace tldtable {
+
+const int bucketCount = %d;
+const int slotCount = %d;
+const int maxTldLength = %d;
+
+// clang-format off
+const char *const tlds[] = {
+%s
+};
+
+const uint32_t displacements[bucketCount] = {
+%s
+};
+
+const int16_t slots[slotCount] = {
+%s
+};
+// clang-format on
+
+}  // namespace tldtable
+}  // namespace messages
+}  // namespace chatterino
+""" % (BUCKET_COUNT, SLOT_COUNT, max(len(tld) for tld in tlds),
+       format_array(['"%s"' % tld for tld in tlds], 8), format_array(displacements, 12),
+       format_array(slots, 16))
+
+    path = os.path.join("src", "messages", "tldtable.hpp")
+    with open(path, "w", newline="\n") as file:
+        file.write(output)
+
+    print("wrote %d tlds to %s" % (len(tlds), path))
+
+
+if __name__ == "__main__":
+    main()